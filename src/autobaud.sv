@@ -0,0 +1,225 @@
+/*           __        _
+ *  ________/ /  ___ _(_)__  ___
+ * / __/ __/ _ \/ _ `/ / _ \/ -_)
+ * \__/\__/_//_/\_,_/_/_//_/\__/
+ *
+ * Copyright (C) Clément Chaine
+ * This file is part of ECAP5-DWBUART <https://github.com/ecap5/ECAP5-DWBUART>
+ *
+ * ECAP5-DWBUART is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ECAP5-DWBUART is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ECAP5-DWBUART.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+module autobaud #(
+  parameter int WIDTH_SIZE = 20
+)(
+  input   logic         clk_i,
+  input   logic         rst_i,
+
+  input   logic         enable_i,
+  // Number of data and parity bits following the start bit
+  input   logic[3:0]    frame_bits_i,
+
+  input   logic         uart_rx_i,
+
+  output  logic[WIDTH_SIZE-1:0] width_o,
+  // Accumulator increment with its 8-bit fractional part
+  output  logic[23:0]   acc_incr_o,
+  output  logic         done_o
+);
+
+/*****************************************/
+/*           Internal signals            */
+/*****************************************/
+
+typedef enum {
+  IDLE,     // 0
+  START,    // 1
+  MEASURE,  // 2
+  WAIT      // 3
+} state_t;
+state_t state_d, state_q;
+
+logic uart_rx_q, uart_rx_qq;
+
+// Width of the start bit in clock cycles
+logic[WIDTH_SIZE-1:0] width_d, width_q;
+
+// Cycle and bit counters used to wait for the end of the character
+logic[WIDTH_SIZE-1:0] cycle_cnt_d, cycle_cnt_q;
+logic[3:0] bit_cnt_d, bit_cnt_q;
+logic char_done;
+
+// Restoring divider computing 2^25 / width
+logic[4:0]  div_cnt_d, div_cnt_q;
+logic[WIDTH_SIZE:0] div_rem_d, div_rem_q, div_rem_shifted;
+logic[25:0] div_quot_d, div_quot_q;
+logic div_done;
+
+/*****************************************/
+/*            Output signals             */
+/*****************************************/
+
+logic[23:0] acc_incr;
+logic done;
+
+/*****************************************/
+
+always_comb begin : state_machine
+  state_d = state_q;
+
+  case(state_q)
+    IDLE: begin
+      // The line shall be idle before measuring, so that a character being
+      // received when the measure is requested is not measured
+      if(enable_i && uart_rx_qq) begin
+        state_d = START;
+      end
+    end
+    START: begin
+      // Wait for the beginning of the start bit
+      if(uart_rx_qq == 0) begin
+        state_d = MEASURE;
+      end
+    end
+    MEASURE: begin
+      // Wait for the end of the start bit
+      if(uart_rx_qq) begin
+        state_d = WAIT;
+      end
+    end
+    WAIT: begin
+      // Wait for the division and for the middle of the stop bit
+      if(div_done && char_done) begin
+        state_d = IDLE;
+      end
+    end
+    default: begin end
+  endcase
+
+  if(!enable_i) begin
+    state_d = IDLE;
+  end
+end
+
+always_comb begin : measure
+  width_d = width_q;
+  cycle_cnt_d = cycle_cnt_q;
+  bit_cnt_d = bit_cnt_q;
+
+  // The middle of the stop bit is reached half a bit after the last data or parity bit
+  char_done = (bit_cnt_q == frame_bits_i) && (cycle_cnt_q >= (width_q >> 1));
+
+  case(state_q)
+    START: begin
+      cycle_cnt_d = '0;
+    end
+    MEASURE: begin
+      // The width saturates for very low baud rates
+      if(cycle_cnt_q != '1) begin
+        cycle_cnt_d = cycle_cnt_q + 1;
+      end
+      bit_cnt_d = '0;
+
+      // The previous measure is kept until the end of the start bit
+      if(uart_rx_qq) begin
+        width_d = cycle_cnt_d;
+        cycle_cnt_d = '0;
+      end
+    end
+    WAIT: begin
+      cycle_cnt_d = cycle_cnt_q + 1;
+      if((cycle_cnt_q + 1) >= width_q) begin
+        if(bit_cnt_q != frame_bits_i) begin
+          cycle_cnt_d = '0;
+          bit_cnt_d = bit_cnt_q + 1;
+        end
+      end
+    end
+    default: begin end
+  endcase
+end
+
+always_comb begin : divide
+  div_cnt_d = div_cnt_q;
+  div_rem_d = div_rem_q;
+  div_quot_d = div_quot_q;
+
+  div_done = (div_cnt_q == '0);
+
+  // The dividend 2^25 only has its highest bit set
+  div_rem_shifted = {div_rem_q[WIDTH_SIZE-1:0], (div_cnt_q == 5'd26)};
+
+  if(state_q == MEASURE) begin
+    div_cnt_d = 5'd26;
+    div_rem_d = '0;
+    div_quot_d = '0;
+  end else if(!div_done) begin
+    div_cnt_d = div_cnt_q - 1;
+    if(div_rem_shifted >= {1'b0, width_q}) begin
+      div_rem_d = div_rem_shifted - {1'b0, width_q};
+      div_quot_d = {div_quot_q[24:0], 1'b1};
+    end else begin
+      div_rem_d = div_rem_shifted;
+      div_quot_d = {div_quot_q[24:0], 1'b0};
+    end
+  end
+
+  // round(2^24 / width), saturating for a width of a single cycle
+  acc_incr = (div_quot_q[25:1] + {24'b0, div_quot_q[0]} > 25'hFFFFFF) ? 24'hFFFFFF
+           : 24'(div_quot_q[25:1] + {24'b0, div_quot_q[0]});
+
+  done = (state_q == WAIT) && div_done && char_done;
+end
+
+always_ff @(posedge clk_i) begin
+  if(rst_i) begin
+    state_q     <= IDLE;
+
+    uart_rx_q   <= 1;
+    uart_rx_qq  <= 1;
+
+    width_q     <= '0;
+    cycle_cnt_q <= '0;
+    bit_cnt_q   <= '0;
+
+    div_cnt_q   <= '0;
+    div_rem_q   <= '0;
+    div_quot_q  <= '0;
+  end else begin
+    state_q <= state_d;
+
+    // The receive input is registered twice to prevent
+    // metastability issues
+    uart_rx_q  <= uart_rx_i;
+    uart_rx_qq <= uart_rx_q;
+
+    width_q     <= width_d;
+    cycle_cnt_q <= cycle_cnt_d;
+    bit_cnt_q   <= bit_cnt_d;
+
+    div_cnt_q   <= div_cnt_d;
+    div_rem_q   <= div_rem_d;
+    div_quot_q  <= div_quot_d;
+  end
+end
+
+/*****************************************/
+/*         Assign output signals         */
+/*****************************************/
+
+assign width_o = width_q;
+assign acc_incr_o = acc_incr;
+assign done_o = done;
+
+endmodule // autobaud
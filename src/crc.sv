@@ -0,0 +1,102 @@
+/*           __        _
+ *  ________/ /  ___ _(_)__  ___
+ * / __/ __/ _ \/ _ `/ / _ \/ -_)
+ * \__/\__/_//_/\_,_/_/_//_/\__/
+ *
+ * Copyright (C) Clément Chaine
+ * This file is part of ECAP5-DWBUART <https://github.com/ecap5/ECAP5-DWBUART>
+ *
+ * ECAP5-DWBUART is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ECAP5-DWBUART is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ECAP5-DWBUART.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+module crc (
+  input   logic         clk_i,
+  input   logic         rst_i,
+
+  // Selects a 32-bit CRC instead of a 16-bit CRC held in the lower half
+  input   logic         cr_w32_i,
+  // Selects a reflected CRC, the bytes being processed lsb first
+  input   logic         cr_ref_i,
+  // Polynomial in normal representation, without its highest term
+  input   logic[31:0]   poly_i,
+  input   logic[31:0]   init_i,
+
+  // The CRC is loaded with init_i before a byte of the same cycle is
+  // accumulated
+  input   logic         clear_i,
+
+  input   logic         valid_i,
+  input   logic[7:0]    data_i,
+
+  output  logic[31:0]   crc_o
+);
+
+/*****************************************/
+/*           Internal signals            */
+/*****************************************/
+
+logic[31:0] crc_d, crc_q;
+
+logic[31:0] mask;
+logic[31:0] poly;
+logic       feedback;
+
+/*****************************************/
+
+always_comb begin : polynomial
+  mask = cr_w32_i ? 32'hFFFF_FFFF : 32'h0000_FFFF;
+  // The reflected CRC shifts right using the bit-reversed polynomial
+  poly = poly_i & mask;
+  if(cr_ref_i) begin
+    for(int i = 0; i < 32; i++) begin
+      poly[i] = cr_w32_i ? poly_i[31 - i] : ((i < 16) ? poly_i[15 - i] : 1'b0);
+    end
+  end
+end
+
+always_comb begin : accumulate
+  crc_d = clear_i ? (init_i & mask) : crc_q;
+  feedback = 0;
+
+  if(valid_i) begin
+    for(int i = 0; i < 8; i++) begin
+      if(cr_ref_i) begin
+        feedback = crc_d[0] ^ data_i[i];
+        crc_d = {1'b0, crc_d[31:1]};
+      end else begin
+        feedback = (cr_w32_i ? crc_d[31] : crc_d[15]) ^ data_i[7 - i];
+        crc_d = {crc_d[30:0], 1'b0} & mask;
+      end
+      if(feedback) begin
+        crc_d = crc_d ^ poly;
+      end
+    end
+  end
+end
+
+always_ff @(posedge clk_i) begin
+  if(rst_i) begin
+    crc_q <= init_i & mask;
+  end else begin
+    crc_q <= crc_d;
+  end
+end
+
+/*****************************************/
+/*         Assign output signals         */
+/*****************************************/
+
+assign crc_o = crc_q;
+
+endmodule // crc
@@ -0,0 +1,352 @@
+/*           __        _
+ *  ________/ /  ___ _(_)__  ___
+ * / __/ __/ _ \/ _ `/ / _ \/ -_)
+ * \__/\__/_//_/\_,_/_/_//_/\__/
+ *
+ * Copyright (C) Clément Chaine
+ * This file is part of ECAP5-DWBUART <https://github.com/ecap5/ECAP5-DWBUART>
+ *
+ * ECAP5-DWBUART is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ECAP5-DWBUART is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ECAP5-DWBUART.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+module dma_master #(
+  parameter int RX_CNT_WIDTH = 5
+)(
+  input   logic         clk_i,
+  input   logic         rst_i,
+
+  //=================================
+  //    Channel registers
+
+  input   logic[31:0]   write_data_i,
+
+  input   logic         tx_addr_write_i,
+  input   logic         tx_len_write_i,
+  output  logic[31:0]   tx_addr_o,
+  output  logic[15:0]   tx_len_o,
+  output  logic         tx_done_o,
+
+  input   logic         rx_addr_write_i,
+  input   logic         rx_len_write_i,
+  output  logic[31:0]   rx_addr_o,
+  output  logic[15:0]   rx_len_o,
+  output  logic         rx_done_o,
+
+  //=================================
+  //    Fifo interface
+
+  // Asserted when an entry can be pushed to the transmit fifo
+  input   logic         tx_fifo_ready_i,
+  output  logic         tx_fifo_write_o,
+  output  logic[35:0]   tx_fifo_wdata_o,
+
+  // Asserted when entries can be popped from the receive fifo
+  input   logic                   rx_fifo_ready_i,
+  input   logic[RX_CNT_WIDTH-1:0] rx_fifo_count_i,
+  input   logic[31:0]             rx_fifo_data_i,
+  output  logic[2:0]              rx_fifo_read_o,
+
+  //=================================
+  //    Wishbone master interface
+
+  output  logic[31:0]   wbm_adr_o,
+  output  logic[31:0]   wbm_dat_o,
+  input   logic[31:0]   wbm_dat_i,
+  output  logic         wbm_we_o,
+  output  logic[3:0]    wbm_sel_o,
+  output  logic         wbm_stb_o,
+  input   logic         wbm_ack_i,
+  output  logic         wbm_cyc_o,
+  input   logic         wbm_stall_i
+);
+
+/*****************************************/
+/*           Internal signals            */
+/*****************************************/
+
+typedef enum {
+  IDLE,     // 0
+  TX_REQ,   // 1
+  TX_WAIT,  // 2
+  RX_REQ,   // 3
+  RX_WAIT   // 4
+} state_t;
+state_t state_d, state_q;
+
+// Current address and number of remaining bytes of each channel
+logic[31:0] tx_addr_d, tx_addr_q,
+            rx_addr_d, rx_addr_q;
+logic[15:0] tx_cnt_d, tx_cnt_q,
+            rx_cnt_d, rx_cnt_q;
+
+// Number of bytes of the transmit access being acknowledged
+logic[2:0]  tx_ack_n;
+
+// Number of bytes and byte lanes of the next access of each channel.
+// An access never crosses a word boundary.
+logic[2:0]  tx_n, rx_n;
+logic[2:0]  tx_lanes_left, rx_lanes_left;
+logic[4:0]  tx_mask, rx_mask;
+logic[3:0]  tx_sel, rx_sel;
+
+// Word fetched by the transmit channel while the fifo was not ready
+logic       tx_buf_valid_d, tx_buf_valid_q;
+logic[35:0] tx_buf_d, tx_buf_q;
+
+// Bytes popped from the receive fifo, waiting to be written
+logic       rx_buf_valid_d, rx_buf_valid_q;
+logic[31:0] rx_buf_d, rx_buf_q;
+logic[3:0]  rx_buf_sel_d, rx_buf_sel_q;
+logic[2:0]  rx_buf_n_d, rx_buf_n_q;
+
+/*****************************************/
+/*            Output signals             */
+/*****************************************/
+
+logic[31:0] wbm_adr_d, wbm_adr_q,
+            wbm_dat_d, wbm_dat_q;
+logic       wbm_we_d, wbm_we_q;
+logic[3:0]  wbm_sel_d, wbm_sel_q;
+logic       wbm_stb_d, wbm_stb_q;
+
+logic       tx_fifo_write;
+logic[35:0] tx_fifo_wdata;
+logic[2:0]  rx_fifo_read;
+
+logic tx_done_d, tx_done_q,
+      rx_done_d, rx_done_q;
+
+/*****************************************/
+
+always_comb begin : transfers
+  state_d = state_q;
+
+  wbm_stb_d = wbm_stb_q;
+
+  tx_addr_d = tx_addr_q;
+  tx_cnt_d = tx_cnt_q;
+  rx_addr_d = rx_addr_q;
+  rx_cnt_d = rx_cnt_q;
+
+  tx_buf_valid_d = tx_buf_valid_q;
+  tx_buf_d = tx_buf_q;
+  rx_buf_valid_d = rx_buf_valid_q;
+  rx_buf_d = rx_buf_q;
+  rx_buf_sel_d = rx_buf_sel_q;
+  rx_buf_n_d = rx_buf_n_q;
+
+  tx_fifo_write = 0;
+  tx_fifo_wdata = tx_buf_q;
+  rx_fifo_read = '0;
+
+  wbm_adr_d = wbm_adr_q;
+  wbm_dat_d = wbm_dat_q;
+  wbm_we_d  = wbm_we_q;
+  wbm_sel_d = wbm_sel_q;
+
+  rx_done_d = 0;
+
+  //=================================
+  //    Responses
+
+  // The size of the acknowledged transmit access is given by its byte lanes
+  tx_ack_n = 3'(wbm_sel_q[0]) + 3'(wbm_sel_q[1]) + 3'(wbm_sel_q[2]) + 3'(wbm_sel_q[3]);
+
+  // A word which could not be pushed when fetched is pushed first
+  if(tx_buf_valid_q && tx_fifo_ready_i) begin
+    tx_fifo_write = 1;
+    tx_buf_valid_d = 0;
+  end
+
+  case(state_q)
+    TX_REQ,
+    RX_REQ: begin
+      // The request is accepted when the slave does not stall
+      if(!wbm_stall_i) begin
+        wbm_stb_d = 0;
+        state_d = (state_q == TX_REQ) ? TX_WAIT : RX_WAIT;
+      end
+    end
+    TX_WAIT: begin
+      if(wbm_ack_i) begin
+        tx_addr_d = tx_addr_q + 32'(tx_ack_n);
+        tx_cnt_d = (tx_cnt_q > 16'(tx_ack_n)) ? tx_cnt_q - 16'(tx_ack_n) : '0;
+        // The fetched word is pushed to the transmit fifo along with its
+        // byte lanes, which are sent from the lowest to the highest
+        if(tx_fifo_ready_i) begin
+          tx_fifo_write = 1;
+          tx_fifo_wdata = {wbm_sel_q, wbm_dat_i};
+        end else begin
+          tx_buf_valid_d = 1;
+          tx_buf_d = {wbm_sel_q, wbm_dat_i};
+        end
+        state_d = IDLE;
+      end
+    end
+    RX_WAIT: begin
+      if(wbm_ack_i) begin
+        rx_addr_d = rx_addr_q + 32'(rx_buf_n_q);
+        rx_cnt_d = (rx_cnt_q > 16'(rx_buf_n_q)) ? rx_cnt_q - 16'(rx_buf_n_q) : '0;
+        rx_done_d = (rx_cnt_q <= 16'(rx_buf_n_q));
+        rx_buf_valid_d = 0;
+        state_d = IDLE;
+      end
+    end
+    default: begin end
+  endcase
+
+  // The transmit channel is done once its last word is in the fifo
+  tx_done_d = tx_fifo_write && (tx_cnt_d == '0);
+
+  // Writing the registers of a channel restarts it, a non-null length
+  // starting the transfers
+  if(tx_addr_write_i) begin
+    tx_addr_d = write_data_i;
+  end
+  if(tx_len_write_i) begin
+    tx_cnt_d = write_data_i[15:0];
+  end
+  if(rx_addr_write_i) begin
+    rx_addr_d = write_data_i;
+  end
+  if(rx_len_write_i) begin
+    rx_cnt_d = write_data_i[15:0];
+  end
+
+  //=================================
+  //    Requests
+
+  // The next accesses are computed from the updated channel state so that
+  // they can directly follow an acknowledge.
+  // Transmit accesses are limited by the number of remaining bytes.
+  tx_lanes_left = 3'd4 - {1'b0, tx_addr_d[1:0]};
+  tx_n = (tx_cnt_d < 16'(tx_lanes_left)) ? tx_cnt_d[2:0] : tx_lanes_left;
+  tx_mask = (5'b1 << tx_n) - 1;
+  tx_sel = 4'(tx_mask << tx_addr_d[1:0]);
+
+  // Receive accesses are also limited by the number of received bytes
+  rx_lanes_left = 3'd4 - {1'b0, rx_addr_d[1:0]};
+  rx_n = (rx_cnt_d < 16'(rx_lanes_left)) ? rx_cnt_d[2:0] : rx_lanes_left;
+  if(16'(rx_n) > 16'(rx_fifo_count_i)) begin
+    rx_n = 3'(rx_fifo_count_i);
+  end
+  rx_mask = (5'b1 << rx_n) - 1;
+  rx_sel = 4'(rx_mask << rx_addr_d[1:0]);
+
+  // The received bytes are popped and moved to the byte lanes of the
+  // next access
+  if(!rx_buf_valid_d && (rx_cnt_d != '0) && (rx_n != '0) && rx_fifo_ready_i) begin
+    rx_fifo_read = rx_n;
+    rx_buf_valid_d = 1;
+    rx_buf_d = rx_fifo_data_i << {rx_addr_d[1:0], 3'b0};
+    rx_buf_sel_d = rx_sel;
+    rx_buf_n_d = rx_n;
+  end
+
+  // A new access is started either when idle or right after the
+  // acknowledge of the previous one, the cycle being held for consecutive
+  // accesses. The receive channel has priority as the receive fifo can
+  // overrun.
+  if(state_d == IDLE) begin
+    if(rx_buf_valid_d) begin
+      state_d = RX_REQ;
+      wbm_adr_d = {rx_addr_d[31:2], 2'b0};
+      wbm_dat_d = rx_buf_d;
+      wbm_we_d = 1;
+      wbm_sel_d = rx_buf_sel_d;
+      wbm_stb_d = 1;
+    end else if((tx_cnt_d != '0) && !tx_buf_valid_d) begin
+      state_d = TX_REQ;
+      wbm_adr_d = {tx_addr_d[31:2], 2'b0};
+      wbm_we_d = 0;
+      wbm_sel_d = tx_sel;
+      wbm_stb_d = 1;
+    end
+  end
+end
+
+always_ff @(posedge clk_i) begin
+  if(rst_i) begin
+    state_q <= IDLE;
+
+    tx_addr_q <= '0;
+    tx_cnt_q <= '0;
+    rx_addr_q <= '0;
+    rx_cnt_q <= '0;
+
+    tx_buf_valid_q <= 0;
+    tx_buf_q <= '0;
+    rx_buf_valid_q <= 0;
+    rx_buf_q <= '0;
+    rx_buf_sel_q <= '0;
+    rx_buf_n_q <= '0;
+
+    wbm_adr_q <= '0;
+    wbm_dat_q <= '0;
+    wbm_we_q <= 0;
+    wbm_sel_q <= '0;
+    wbm_stb_q <= 0;
+
+    tx_done_q <= 0;
+    rx_done_q <= 0;
+  end else begin
+    state_q <= state_d;
+
+    tx_addr_q <= tx_addr_d;
+    tx_cnt_q <= tx_cnt_d;
+    rx_addr_q <= rx_addr_d;
+    rx_cnt_q <= rx_cnt_d;
+
+    tx_buf_valid_q <= tx_buf_valid_d;
+    tx_buf_q <= tx_buf_d;
+    rx_buf_valid_q <= rx_buf_valid_d;
+    rx_buf_q <= rx_buf_d;
+    rx_buf_sel_q <= rx_buf_sel_d;
+    rx_buf_n_q <= rx_buf_n_d;
+
+    wbm_adr_q <= wbm_adr_d;
+    wbm_dat_q <= wbm_dat_d;
+    wbm_we_q <= wbm_we_d;
+    wbm_sel_q <= wbm_sel_d;
+    wbm_stb_q <= wbm_stb_d;
+
+    tx_done_q <= tx_done_d;
+    rx_done_q <= rx_done_d;
+  end
+end
+
+/*****************************************/
+/*         Assign output signals         */
+/*****************************************/
+
+assign tx_addr_o = tx_addr_q;
+assign tx_len_o = tx_cnt_q;
+assign tx_done_o = tx_done_q;
+assign rx_addr_o = rx_addr_q;
+assign rx_len_o = rx_cnt_q;
+assign rx_done_o = rx_done_q;
+
+assign tx_fifo_write_o = tx_fifo_write;
+assign tx_fifo_wdata_o = tx_fifo_wdata;
+assign rx_fifo_read_o = rx_fifo_read;
+
+assign wbm_adr_o = wbm_adr_q;
+assign wbm_dat_o = wbm_dat_q;
+assign wbm_we_o  = wbm_we_q;
+assign wbm_sel_o = wbm_sel_q;
+assign wbm_stb_o = wbm_stb_q;
+// The cycle is held from the first request to the last acknowledge
+assign wbm_cyc_o = (state_q != IDLE);
+
+endmodule // dma_master
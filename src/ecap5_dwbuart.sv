@@ -21,10 +21,58 @@
  */
 
 module ecap5_dwbuart #(
-  localparam logic[2:0] UART_SR   = 0,
-  localparam logic[2:0] UART_CR   = 1,
-  localparam logic[2:0] UART_RXDR = 2,
-  localparam logic[2:0] UART_TXDR = 3,
+  // Number of received frames buffered before an overrun occurs
+  parameter int RX_FIFO_DEPTH = 16,
+  // Number of frames queued for transmission
+  parameter int TX_FIFO_DEPTH = 16,
+  // When set, the registers are accessed through the register interface
+  // instead of the memory interface, so that several peripherals can share
+  // a single wishbone slave
+  parameter bit SHARED_SLAVE  = 0,
+  // When cleared, the DMA master, the DMA handshake and the streaming
+  // interfaces are removed. Their registers and control fields read as
+  // zero and ignore writes.
+  parameter bit DMA_ENABLE    = 1,
+
+  localparam logic[5:0] UART_SR    = 0,
+  localparam logic[5:0] UART_CR    = 1,
+  localparam logic[5:0] UART_RXDR  = 2,
+  localparam logic[5:0] UART_TXDR  = 3,
+  localparam logic[5:0] UART_IER   = 4,
+  localparam logic[5:0] UART_ISR   = 5,
+  localparam logic[5:0] UART_TXPDR = 6,
+  localparam logic[5:0] UART_RXPDR = 7,
+  localparam logic[5:0] UART_RTOR  = 8,
+  localparam logic[5:0] UART_FSCR  = 9,
+  localparam logic[5:0] UART_ABR   = 10,
+  localparam logic[5:0] UART_CR2   = 11,
+  localparam logic[5:0] UART_TXDAR = 12,
+  localparam logic[5:0] UART_TXDLR = 13,
+  localparam logic[5:0] UART_RXDAR = 14,
+  localparam logic[5:0] UART_RXDLR = 15,
+  localparam logic[5:0] UART_DER   = 16,
+  localparam logic[5:0] UART_CR3   = 17,
+  localparam logic[5:0] UART_TXFCR = 18,
+  localparam logic[5:0] UART_RXFCR = 19,
+  localparam logic[5:0] UART_PECR  = 20,
+  localparam logic[5:0] UART_FECR  = 21,
+  localparam logic[5:0] UART_OECR  = 22,
+  localparam logic[5:0] UART_FSTCR = 23,
+  localparam logic[5:0] UART_RXTSR = 24,
+  localparam logic[5:0] UART_TXTSR = 25,
+  localparam logic[5:0] UART_TSCR  = 26,
+  localparam logic[5:0] UART_CMR   = 27,
+  localparam logic[5:0] UART_CRCCR = 28,
+  localparam logic[5:0] UART_CRCPR = 29,
+  localparam logic[5:0] UART_CRCIR = 30,
+  localparam logic[5:0] UART_TXCRCR = 31,
+  localparam logic[5:0] UART_RXCRCR = 32,
+
+  localparam int RX_CNT_WIDTH = $clog2(RX_FIFO_DEPTH + 1),
+
+  // RTS is deasserted once the receive fifo holds this number of frames,
+  // leaving room for a frame already started by the remote transmitter
+  localparam int RTS_LEVEL = (RX_FIFO_DEPTH > 1) ? RX_FIFO_DEPTH - 1 : 1,
 
   // The minimum frame size is :
   //   - 7 data bits
@@ -40,6 +88,8 @@ module ecap5_dwbuart #(
   input   logic         clk_i,
   input   logic         rst_i,
 
+  output  logic         irq_o,
+
   //=================================
   //    Memory interface
 
@@ -53,11 +103,63 @@ module ecap5_dwbuart #(
   input   logic        wb_cyc_i,
   output  logic        wb_stall_o,
 
+  //=================================
+  //    Register interface
+
+  input   logic[31:0]  reg_addr_i,
+  input   logic        reg_read_i,
+  output  logic[31:0]  reg_read_data_o,
+  input   logic        reg_write_i,
+  input   logic[31:0]  reg_write_data_i,
+  input   logic[3:0]   reg_sel_i,
+
   //=================================
   //    Serial interface
   
   input  logic uart_rx_i,
-  output logic uart_tx_o
+  output logic uart_tx_o,
+  // RS-485 driver enable
+  output logic uart_de_o,
+
+  //=================================
+  //    Flow control interface
+
+  input  logic uart_cts_i,
+  output logic uart_rts_o,
+
+  //=================================
+  //    DMA interface
+
+  output logic dma_rx_req_o,
+  input  logic dma_rx_ack_i,
+  output logic dma_tx_req_o,
+  input  logic dma_tx_ack_i,
+
+  //=================================
+  //    DMA master interface
+
+  output logic[31:0]  wbm_adr_o,
+  output logic[31:0]  wbm_dat_o,
+  input  logic[31:0]  wbm_dat_i,
+  output logic        wbm_we_o,
+  output logic[3:0]   wbm_sel_o,
+  output logic        wbm_stb_o,
+  input  logic        wbm_ack_i,
+  output logic        wbm_cyc_o,
+  input  logic        wbm_stall_i,
+
+  //=================================
+  //    Streaming interface
+
+  input  logic        stream_tx_valid_i,
+  input  logic[7:0]   stream_tx_data_i,
+  output logic        stream_tx_ready_o,
+
+  output logic        stream_rx_valid_o,
+  output logic[7:0]   stream_rx_data_o,
+  // Noise, framing and parity errors of the received frame
+  output logic[2:0]   stream_rx_err_o,
+  input  logic        stream_rx_ready_i
 );
 
 /*****************************************/
@@ -65,37 +167,222 @@ module ecap5_dwbuart #(
 /*****************************************/
 
 logic frontend_rst;
+logic autobaud_rst;
+// Asserted on a write to UART_CR which is not shadowed
+logic cr_write_rst;
 
 logic[31:0] mem_addr;
 logic       mem_read, mem_write;
 logic[31:0] mem_read_data_d, mem_read_data_q, 
             mem_write_data;
+logic[3:0]  mem_sel;
 
 logic[MAX_FRAME_SIZE-1:0] rx_frame;
 logic rx_parity_err;
 logic rx_frame_err;
+logic rx_noise_err;
+logic rx_break;
 logic rx_valid;
+logic rx_addr_match;
+logic rx_overrun;
+logic rx_timeout;
+logic rx_false_start;
+logic rx_idle;
+// Data bits of a frame, according to the DS field of UART_CR
+logic[7:0]  data_mask;
+// Asserted when a received frame matches an enabled match character
+logic       rx_char_match;
+
+logic       rx_fifo_write;
+logic[2:0]  rx_fifo_read, rx_fifo_cpu_read;
+// The four oldest received bytes, the oldest one in the lowest byte lane
+logic[31:0] rx_fifo_data;
+logic       rx_fifo_empty, rx_fifo_full;
+logic[RX_CNT_WIDTH-1:0] rx_fifo_count;
+// Timestamp of the oldest received frame
+logic[31:0] rx_ts_fifo_data;
+
+logic[3:0]  ab_frame_bits;
+logic[19:0] ab_width;
+logic[23:0] ab_acc_incr;
+logic       ab_done;
+
+logic tx_transmit,
+      tx_ready,
+      tx_serial,
+      tx_de,
+      tx_break_done,
+      tx_start,
+      tx_done,
+      tx_idle;
 
-logic tx_transmit_d, tx_transmit_q,
-      tx_done;
+logic       tx_fifo_write, tx_fifo_cpu_write, tx_fifo_read;
+logic[36:0] tx_fifo_wdata, tx_fifo_cpu_wdata, tx_fifo_data;
+logic       tx_fifo_empty, tx_fifo_full;
+
+// The processor has priority over the DMA master for the fifo accesses
+logic       dma_tx_fifo_ready, dma_tx_fifo_write;
+logic[35:0] dma_tx_fifo_wdata;
+logic       dma_rx_fifo_ready;
+logic[2:0]  dma_rx_fifo_read;
+
+logic[31:0] dma_tx_addr, dma_rx_addr;
+logic[15:0] dma_tx_len, dma_rx_len;
+logic       dma_tx_done, dma_rx_done;
+
+// Serial input of the receiver, either from the pin or looped back
+logic rx_serial;
+// Asserted when the receive input is echoed on the pin in line monitor mode
+logic line_echo;
+
+// Receive input delayed for the line monitor echo
+logic uart_echo_q, uart_echo_qq;
+
+// Synchronized clear to send input, asserted low
+logic uart_cts_q, uart_cts_qq;
+
+// Byte lanes of the fifo head which remain to be transmitted
+logic[3:0]  tx_lanes, tx_lane;
+logic[3:0]  tx_consumed_d, tx_consumed_q;
+logic[7:0]  tx_data;
+logic       tx_mark;
 
 /*****************************************/
 /*        Memory mapped registers        */
 /*****************************************/
 
 logic[15:0] cr_acc_incr_d, cr_acc_incr_q;
-logic       cr_ds_d, cr_ds_q,
+logic[7:0]  cr_acc_frac_d, cr_acc_frac_q;
+logic       cr_rtse_d, cr_rtse_q,
+            cr_ctse_d, cr_ctse_q,
+            cr_abe_d, cr_abe_q,
+            cr_ovs_d, cr_ovs_q,
+            cr_ds_d, cr_ds_q,
             cr_s_d, cr_s_q;
 logic[1:0]  cr_p_d, cr_p_q;
 
-logic sr_pe_d, sr_pe_q,
+// UART_CR is loaded either from a write or from the shadowed value
+logic       cr_load;
+logic[31:0] cr_load_data;
+// Shadowed UART_CR value waiting for a frame boundary
+logic[31:0] cr_shadow_d, cr_shadow_q;
+logic       cr_pending_d, cr_pending_q;
+logic       cr_apply;
+
+logic cr2_txse_d, cr2_txse_q,
+      cr2_rxse_d, cr2_rxse_q,
+      cr2_txdmae_d, cr2_txdmae_q,
+      cr2_rxdmae_d, cr2_rxdmae_q,
+      cr2_shd_d, cr2_shd_q,
+      cr2_sbk_d, cr2_sbk_q,
+      cr2_mpe_d, cr2_mpe_q;
+logic[7:0] cr2_brkl_d, cr2_brkl_q,
+           cr2_add_d, cr2_add_q,
+           cr2_msk_d, cr2_msk_q;
+
+logic[7:0] rtor_rto_d, rtor_rto_q;
+
+logic      der_dem_d, der_dem_q;
+logic[7:0] der_deat_d, der_deat_q,
+           der_dedt_d, der_dedt_q;
+
+logic cr3_lme_d, cr3_lme_q,
+      cr3_lbe_d, cr3_lbe_q;
+
+logic      cmr_cme1_d, cmr_cme1_q,
+           cmr_cme0_d, cmr_cme0_q;
+logic[7:0] cmr_chr1_d, cmr_chr1_q,
+           cmr_chr0_d, cmr_chr0_q;
+
+logic[15:0] fscr_cnt_d, fscr_cnt_q;
+
+// Free-running cycle counter used to timestamp the frames
+logic[31:0] ts_cnt_d, ts_cnt_q;
+logic[31:0] txtsr_ts_d, txtsr_ts_q;
+
+logic crccr_ref_d, crccr_ref_q,
+      crccr_w32_d, crccr_w32_q,
+      crccr_rxce_d, crccr_rxce_q,
+      crccr_txce_d, crccr_txce_q;
+logic[31:0] crcpr_poly_d, crcpr_poly_q,
+            crcir_init_d, crcir_init_q;
+
+logic       tx_crc_clear, tx_crc_valid,
+            rx_crc_clear, rx_crc_valid;
+logic[31:0] tx_crc, rx_crc;
+
+// Live statistics counters, captured in the snapshot registers below
+// and cleared when UART_TXFCR is read
+logic       stat_snap;
+logic[31:0] stat_txf_d, stat_txf_q,
+            stat_rxf_d, stat_rxf_q,
+            stat_pe_d, stat_pe_q,
+            stat_fe_d, stat_fe_q,
+            stat_oe_d, stat_oe_q,
+            stat_fs_d, stat_fs_q;
+// Asserted from the end of a break until the next frame starts
+logic       stat_brk_d, stat_brk_q;
+
+logic[31:0] rxfcr_cnt_d, rxfcr_cnt_q,
+            pecr_cnt_d, pecr_cnt_q,
+            fecr_cnt_d, fecr_cnt_q,
+            oecr_cnt_d, oecr_cnt_q,
+            fstcr_cnt_d, fstcr_cnt_q;
+
+logic sr_cmf_d, sr_cmf_q,
+      sr_adm_d, sr_adm_q,
+      sr_brk_d, sr_brk_q,
+      sr_nf_d, sr_nf_q,
+      sr_rto_d, sr_rto_q,
+      sr_pe_d, sr_pe_q,
       sr_fe_d, sr_fe_q,
       sr_rxoe_d, sr_rxoe_q,
-      sr_txe_d, sr_txe_q,
-      sr_rxne_d, sr_rxne_q;
+      sr_txf,
+      sr_txe,
+      sr_tc,
+      sr_rxne;
+logic[15:0] sr_rxlvl;
+logic[7:0]  rxpdr_cnt;
+
+logic ier_cm_d, ier_cm_q,
+      ier_adm_d, ier_adm_q,
+      ier_brk_d, ier_brk_q,
+      ier_rxdc_d, ier_rxdc_q,
+      ier_txdc_d, ier_txdc_q,
+      ier_rto_d, ier_rto_q,
+      ier_pe_d, ier_pe_q,
+      ier_fe_d, ier_fe_q,
+      ier_rxoe_d, ier_rxoe_q,
+      ier_txe_d, ier_txe_q,
+      ier_rxne_d, ier_rxne_q;
+
+logic isr_cm_d, isr_cm_q,
+      isr_adm_d, isr_adm_q,
+      isr_brk_d, isr_brk_q,
+      isr_rxdc_d, isr_rxdc_q,
+      isr_txdc_d, isr_txdc_q,
+      isr_rto_d, isr_rto_q,
+      isr_pe_d, isr_pe_q,
+      isr_fe_d, isr_fe_q,
+      isr_rxoe_d, isr_rxoe_q,
+      isr_txe,
+      isr_rxne;
+
+/*****************************************/
+/*            Output signals             */
+/*****************************************/
+
+logic irq_d, irq_q;
+
+logic uart_rts_d, uart_rts_q;
+
+logic dma_rx_req_d, dma_rx_req_q,
+      dma_tx_req_d, dma_tx_req_q;
 
-logic[7:0] rxdr_rxd_d, rxdr_rxd_q;
-logic[7:0] txdr_txd_d, txdr_txd_q;
+logic       stream_tx_ready, stream_tx_write;
+logic       stream_rx_valid_d, stream_rx_valid_q;
+logic[7:0]  stream_rx_data_d, stream_rx_data_q;
+logic[2:0]  stream_rx_err_d, stream_rx_err_q;
 
 /*****************************************/
 
@@ -106,16 +393,120 @@ rx_frontend #(
   .clk_i (clk_i),   .rst_i (frontend_rst),
 
   .cr_acc_incr_i   (cr_acc_incr_q),
+  .cr_acc_frac_i   (cr_acc_frac_q),
   .cr_ds_i        (cr_ds_q),
   .cr_s_i         (cr_s_q),
   .cr_p_i         (cr_p_q),
+  .cr_ovs_i       (cr_ovs_q),
 
-  .uart_rx_i      (uart_rx_i),
+  .cr_mpe_i       (cr2_mpe_q),
+  .mpe_addr_i     (cr2_add_q),
+  .mpe_mask_i     (cr2_msk_q),
+
+  .rtor_rto_i     (rtor_rto_q),
+
+  .uart_rx_i      (rx_serial),
   
   .frame_o        (rx_frame),
   .parity_err_o   (rx_parity_err),
   .frame_err_o    (rx_frame_err),
-  .output_valid_o (rx_valid)
+  .noise_err_o    (rx_noise_err),
+  .break_o        (rx_break),
+  .output_valid_o (rx_valid),
+  .addr_match_o   (rx_addr_match),
+  .false_start_o  (rx_false_start),
+  .timeout_o      (rx_timeout),
+  .idle_o         (rx_idle)
+);
+
+fifo #(
+  .DATA_WIDTH (8),
+  .DEPTH      (RX_FIFO_DEPTH),
+  .NUM_READ   (4)
+) rx_fifo_inst (
+  .clk_i (clk_i),   .rst_i (rst_i),
+
+  .write_i (rx_fifo_write),
+  .data_i  (rx_frame[7:0]),
+
+  .read_i  (rx_fifo_read),
+  .data_o  (rx_fifo_data),
+
+  .empty_o (rx_fifo_empty),
+  .full_o  (rx_fifo_full),
+  .count_o (rx_fifo_count)
+);
+
+// The timestamps are queued alongside the received frames so that both
+// fifos always hold the same number of entries. The timestamps are
+// therefore popped along with the frames, but only the oldest one is
+// output.
+fifo #(
+  .DATA_WIDTH (32),
+  .DEPTH      (RX_FIFO_DEPTH),
+  .NUM_READ   (4),
+  .NUM_OUT    (1)
+) rx_ts_fifo_inst (
+  .clk_i (clk_i),   .rst_i (rst_i),
+
+  .write_i (rx_fifo_write),
+  .data_i  (ts_cnt_q),
+
+  .read_i  (rx_fifo_read),
+  .data_o  (rx_ts_fifo_data),
+
+  .empty_o (),
+  .full_o  (),
+  .count_o ()
+);
+
+// The CRC engines accumulate the bytes sent to the transmit frontend and
+// the bytes output by the receive frontend
+crc tx_crc_inst (
+  .clk_i (clk_i),   .rst_i (rst_i),
+
+  .cr_w32_i  (crccr_w32_q),
+  .cr_ref_i  (crccr_ref_q),
+  .poly_i    (crcpr_poly_q),
+  .init_i    (crcir_init_q),
+
+  .clear_i   (tx_crc_clear),
+
+  .valid_i   (tx_crc_valid),
+  .data_i    (tx_data & data_mask),
+
+  .crc_o     (tx_crc)
+);
+
+crc rx_crc_inst (
+  .clk_i (clk_i),   .rst_i (rst_i),
+
+  .cr_w32_i  (crccr_w32_q),
+  .cr_ref_i  (crccr_ref_q),
+  .poly_i    (crcpr_poly_q),
+  .init_i    (crcir_init_q),
+
+  .clear_i   (rx_crc_clear),
+
+  .valid_i   (rx_crc_valid),
+  .data_i    (rx_frame[7:0] & data_mask),
+
+  .crc_o     (rx_crc)
+);
+
+autobaud #(
+  .WIDTH_SIZE (20)
+) autobaud_inst (
+  .clk_i (clk_i),   .rst_i (autobaud_rst),
+
+  .enable_i     (cr_abe_q),
+  .frame_bits_i (ab_frame_bits),
+
+  .uart_rx_i    (rx_serial),
+
+  .width_o      (ab_width),
+  .acc_incr_o   (ab_acc_incr),
+  .done_o       (ab_done)
 );
 
 tx_frontend #(
@@ -125,153 +516,997 @@ tx_frontend #(
   .clk_i (clk_i),   .rst_i (frontend_rst),
 
   .cr_acc_incr_i   (cr_acc_incr_q),
+  .cr_acc_frac_i   (cr_acc_frac_q),
   .cr_ds_i        (cr_ds_q),
   .cr_s_i         (cr_s_q),
   .cr_p_i         (cr_p_q),
+  .cr_mpe_i       (cr2_mpe_q),
+
+  .transmit_i     (tx_transmit),
+  .dr_i           (tx_data),
+  .mark_i         (tx_mark),
+  .ready_o        (tx_ready),
 
-  .transmit_i     (tx_transmit_q),
-  .dr_i           (txdr_txd_q),
+  .break_i        (cr2_sbk_q && !line_echo),
+  .break_len_i    (cr2_brkl_q),
+  .break_done_o   (tx_break_done),
+
+  // The guard times are only inserted when the driver enable is used
+  .de_lead_i      (der_dem_q ? der_deat_q : '0),
+  .de_trail_i     (der_dem_q ? der_dedt_q : '0),
 
   .done_o         (tx_done),
+  .start_o        (tx_start),
+  .idle_o         (tx_idle),
 
-  .uart_tx_o      (uart_tx_o)
+  .uart_tx_o      (tx_serial),
+  .uart_de_o      (tx_de)
 );
 
-ecap5_dwbmmsc wb_interface_inst (
+// Each entry holds a 32-bit word along with its valid byte lanes and the
+// address mark of a single byte
+fifo #(
+  .DATA_WIDTH (37),
+  .DEPTH      (TX_FIFO_DEPTH)
+) tx_fifo_inst (
   .clk_i (clk_i),   .rst_i (rst_i),
-  
-  .wb_adr_i (wb_adr_i),  .wb_dat_o (wb_dat_o),  .wb_dat_i   (wb_dat_i),
-  .wb_we_i  (wb_we_i),   .wb_sel_i (wb_sel_i),  .wb_stb_i   (wb_stb_i),
-  .wb_ack_o (wb_ack_o),  .wb_cyc_i (wb_cyc_i),  .wb_stall_o (wb_stall_o),
-
-  .addr_o       (mem_addr),
-  .read_o       (mem_read),
-  .read_data_i  (mem_read_data_q),
-  .write_o      (mem_write),
-  .write_data_o (mem_write_data),
-  .sel_o          ()
+
+  .write_i (tx_fifo_write),
+  .data_i  (tx_fifo_wdata),
+
+  .read_i  (tx_fifo_read),
+  .data_o  (tx_fifo_data),
+
+  .empty_o (tx_fifo_empty),
+  .full_o  (tx_fifo_full),
+  .count_o ()
 );
 
+generate
+  if(DMA_ENABLE) begin : gen_dma
+    dma_master #(
+      .RX_CNT_WIDTH (RX_CNT_WIDTH)
+    ) dma_master_inst (
+      .clk_i           (clk_i),
+      .rst_i           (rst_i),
+
+      .write_data_i    (mem_write_data),
+
+      .tx_addr_write_i (mem_write && (mem_addr[7:2] == UART_TXDAR)),
+      .tx_len_write_i  (mem_write && (mem_addr[7:2] == UART_TXDLR)),
+      .tx_addr_o       (dma_tx_addr),
+      .tx_len_o        (dma_tx_len),
+      .tx_done_o       (dma_tx_done),
+
+      .rx_addr_write_i (mem_write && (mem_addr[7:2] == UART_RXDAR)),
+      .rx_len_write_i  (mem_write && (mem_addr[7:2] == UART_RXDLR)),
+      .rx_addr_o       (dma_rx_addr),
+      .rx_len_o        (dma_rx_len),
+      .rx_done_o       (dma_rx_done),
+
+      .tx_fifo_ready_i (dma_tx_fifo_ready),
+      .tx_fifo_write_o (dma_tx_fifo_write),
+      .tx_fifo_wdata_o (dma_tx_fifo_wdata),
+
+      .rx_fifo_ready_i (dma_rx_fifo_ready),
+      .rx_fifo_count_i (rx_fifo_count),
+      .rx_fifo_data_i  (rx_fifo_data),
+      .rx_fifo_read_o  (dma_rx_fifo_read),
+
+      .wbm_adr_o       (wbm_adr_o),
+      .wbm_dat_o       (wbm_dat_o),
+      .wbm_dat_i       (wbm_dat_i),
+      .wbm_we_o        (wbm_we_o),
+      .wbm_sel_o       (wbm_sel_o),
+      .wbm_stb_o       (wbm_stb_o),
+      .wbm_ack_i       (wbm_ack_i),
+      .wbm_cyc_o       (wbm_cyc_o),
+      .wbm_stall_i     (wbm_stall_i)
+    );
+  end else begin : gen_no_dma
+    // The channel registers read as zero and no access is issued
+    assign dma_tx_addr = '0;
+    assign dma_tx_len = '0;
+    assign dma_tx_done = 0;
+    assign dma_rx_addr = '0;
+    assign dma_rx_len = '0;
+    assign dma_rx_done = 0;
+
+    assign dma_tx_fifo_write = 0;
+    assign dma_tx_fifo_wdata = '0;
+    assign dma_rx_fifo_read = '0;
+
+    assign wbm_adr_o = '0;
+    assign wbm_dat_o = '0;
+    assign wbm_we_o = 0;
+    assign wbm_sel_o = '0;
+    assign wbm_stb_o = 0;
+    assign wbm_cyc_o = 0;
+  end
+endgenerate
+
+generate
+  if(SHARED_SLAVE) begin : gen_shared_slave
+    // The accesses are decoded by the shared wishbone slave
+    assign mem_addr = reg_addr_i;
+    assign mem_read = reg_read_i;
+    assign mem_write = reg_write_i;
+    assign mem_write_data = reg_write_data_i;
+    assign mem_sel = reg_sel_i;
+
+    assign wb_dat_o = '0;
+    assign wb_ack_o = 0;
+    assign wb_stall_o = 0;
+  end else begin : gen_slave
+    ecap5_dwbmmsc wb_interface_inst (
+      .clk_i (clk_i),   .rst_i (rst_i),
+      
+      .wb_adr_i (wb_adr_i),  .wb_dat_o (wb_dat_o),  .wb_dat_i   (wb_dat_i),
+      .wb_we_i  (wb_we_i),   .wb_sel_i (wb_sel_i),  .wb_stb_i   (wb_stb_i),
+      .wb_ack_o (wb_ack_o),  .wb_cyc_i (wb_cyc_i),  .wb_stall_o (wb_stall_o),
+
+      .addr_o       (mem_addr),
+      .read_o       (mem_read),
+      .read_data_i  (mem_read_data_q),
+      .write_o      (mem_write),
+      .write_data_o (mem_write_data),
+      .sel_o        (mem_sel)
+    );
+  end
+endgenerate
+
 always_comb begin : register_access
   cr_acc_incr_d = cr_acc_incr_q;
+  cr_acc_frac_d = cr_acc_frac_q;
+  cr_rtse_d    = cr_rtse_q;
+  cr_ctse_d    = cr_ctse_q;
+  cr_abe_d     = cr_abe_q;
+  cr_ovs_d     = cr_ovs_q;
   cr_ds_d      = cr_ds_q;
   cr_s_d       = cr_s_q;
   cr_p_d       = cr_p_q;
 
+  cr_shadow_d  = cr_shadow_q;
+  cr_pending_d = cr_pending_q;
+
+  cr2_txse_d   = cr2_txse_q;
+  cr2_rxse_d   = cr2_rxse_q;
+  cr2_txdmae_d = cr2_txdmae_q;
+  cr2_rxdmae_d = cr2_rxdmae_q;
+  cr2_shd_d    = cr2_shd_q;
+  cr2_sbk_d    = cr2_sbk_q;
+  cr2_brkl_d   = cr2_brkl_q;
+  cr2_mpe_d    = cr2_mpe_q;
+  cr2_add_d    = cr2_add_q;
+  cr2_msk_d    = cr2_msk_q;
+
+  rtor_rto_d   = rtor_rto_q;
+
+  der_dem_d    = der_dem_q;
+  der_deat_d   = der_deat_q;
+  der_dedt_d   = der_dedt_q;
+
+  cr3_lme_d    = cr3_lme_q;
+  cr3_lbe_d    = cr3_lbe_q;
+
+  crccr_ref_d  = crccr_ref_q;
+  crccr_w32_d  = crccr_w32_q;
+  crccr_rxce_d = crccr_rxce_q;
+  crccr_txce_d = crccr_txce_q;
+  crcpr_poly_d = crcpr_poly_q;
+  crcir_init_d = crcir_init_q;
+
+  cmr_cme1_d   = cmr_cme1_q;
+  cmr_cme0_d   = cmr_cme0_q;
+  cmr_chr1_d   = cmr_chr1_q;
+  cmr_chr0_d   = cmr_chr0_q;
+
+  fscr_cnt_d   = fscr_cnt_q;
+
+  sr_cmf_d     = sr_cmf_q;
+  sr_adm_d     = sr_adm_q;
+  sr_brk_d     = sr_brk_q;
+  sr_nf_d      = sr_nf_q;
+  sr_rto_d     = sr_rto_q;
   sr_pe_d      = sr_pe_q;
   sr_fe_d      = sr_fe_q;
   sr_rxoe_d    = sr_rxoe_q;
-  sr_txe_d     = sr_txe_q;
-  sr_rxne_d    = sr_rxne_q;
 
-  rxdr_rxd_d   = rxdr_rxd_q;
-  txdr_txd_d   = txdr_txd_q;
+  ier_cm_d     = ier_cm_q;
+  ier_adm_d    = ier_adm_q;
+  ier_brk_d    = ier_brk_q;
+  ier_rxdc_d   = ier_rxdc_q;
+  ier_txdc_d   = ier_txdc_q;
+  ier_rto_d    = ier_rto_q;
+  ier_pe_d     = ier_pe_q;
+  ier_fe_d     = ier_fe_q;
+  ier_rxoe_d   = ier_rxoe_q;
+  ier_txe_d    = ier_txe_q;
+  ier_rxne_d   = ier_rxne_q;
+
+  isr_cm_d     = isr_cm_q;
+  isr_adm_d    = isr_adm_q;
+  isr_brk_d    = isr_brk_q;
+  isr_rxdc_d   = isr_rxdc_q;
+  isr_txdc_d   = isr_txdc_q;
+  isr_rto_d    = isr_rto_q;
+  isr_pe_d     = isr_pe_q;
+  isr_fe_d     = isr_fe_q;
+  isr_rxoe_d   = isr_rxoe_q;
+
+  // The status of the fifos is directly reflected in UART_SR
+  sr_txf  = tx_fifo_full;
+  sr_txe  = tx_fifo_empty;
+  // The transmission is only complete once the last frame has left the
+  // transmit frontend
+  sr_tc   = tx_fifo_empty && tx_idle;
+  sr_rxne = !rx_fifo_empty;
+  sr_rxlvl = 16'(rx_fifo_count);
+
+  // UART_RXPDR returns up to three data along with their number
+  rxpdr_cnt = (32'(rx_fifo_count) > 3) ? 8'd3 : 8'(rx_fifo_count);
 
   // Set the data output for read requests
   mem_read_data_d = 0;
-  case(mem_addr[4:2])
-    UART_SR:   mem_read_data_d = {27'b0, sr_pe_q, sr_fe_q, sr_rxoe_q, sr_txe_q, sr_rxne_q};
-    UART_CR:   mem_read_data_d = {cr_acc_incr_q, 12'b0, cr_ds_q, cr_s_q, cr_p_q};
-    UART_RXDR: mem_read_data_d = {24'b0, rxdr_rxd_q};
+  case(mem_addr[7:2])
+    UART_SR:   mem_read_data_d = {sr_rxlvl, 3'b0, sr_tc, sr_cmf_q, sr_adm_q, sr_brk_q, cr_pending_q, sr_nf_q, sr_rto_q, sr_txf, sr_pe_q, sr_fe_q, sr_rxoe_q, sr_txe, sr_rxne};
+    UART_CR:   mem_read_data_d = {cr_acc_incr_q, cr_acc_frac_q, cr_rtse_q, cr_ctse_q, cr_abe_q, cr_ovs_q, cr_ds_q, cr_s_q, cr_p_q};
+    UART_RXDR: mem_read_data_d = {24'b0, rx_fifo_data[7:0]};
+    UART_RXPDR: mem_read_data_d = {rxpdr_cnt, rx_fifo_data[23:0]};
+    UART_RTOR: mem_read_data_d = {24'b0, rtor_rto_q};
+    UART_FSCR: mem_read_data_d = {16'b0, fscr_cnt_q};
+    UART_ABR:  mem_read_data_d = {12'b0, ab_width};
+    UART_CR2:  mem_read_data_d = {cr2_msk_q, cr2_add_q, cr2_brkl_q, 1'b0, cr2_mpe_q, cr2_sbk_q, cr2_txse_q, cr2_rxse_q, cr2_txdmae_q, cr2_rxdmae_q, cr2_shd_q};
+    UART_TXDAR: mem_read_data_d = dma_tx_addr;
+    UART_TXDLR: mem_read_data_d = {16'b0, dma_tx_len};
+    UART_RXDAR: mem_read_data_d = dma_rx_addr;
+    UART_RXDLR: mem_read_data_d = {16'b0, dma_rx_len};
+    UART_DER:  mem_read_data_d = {8'b0, der_dedt_q, der_deat_q, 7'b0, der_dem_q};
+    UART_CR3:  mem_read_data_d = {30'b0, cr3_lme_q, cr3_lbe_q};
+    UART_TXFCR: mem_read_data_d = stat_txf_q;
+    UART_RXFCR: mem_read_data_d = rxfcr_cnt_q;
+    UART_PECR: mem_read_data_d = pecr_cnt_q;
+    UART_FECR: mem_read_data_d = fecr_cnt_q;
+    UART_OECR: mem_read_data_d = oecr_cnt_q;
+    UART_FSTCR: mem_read_data_d = fstcr_cnt_q;
+    UART_RXTSR: mem_read_data_d = rx_ts_fifo_data;
+    UART_TXTSR: mem_read_data_d = txtsr_ts_q;
+    UART_TSCR: mem_read_data_d = ts_cnt_q;
+    UART_CMR:  mem_read_data_d = {14'b0, cmr_cme1_q, cmr_cme0_q, cmr_chr1_q, cmr_chr0_q};
+    UART_CRCCR: mem_read_data_d = {28'b0, crccr_ref_q, crccr_w32_q, crccr_rxce_q, crccr_txce_q};
+    UART_CRCPR: mem_read_data_d = crcpr_poly_q;
+    UART_CRCIR: mem_read_data_d = crcir_init_q;
+    UART_TXCRCR: mem_read_data_d = tx_crc;
+    UART_RXCRCR: mem_read_data_d = rx_crc;
+    UART_IER:  mem_read_data_d = {21'b0, ier_cm_q, ier_adm_q, ier_brk_q, ier_rxdc_q, ier_txdc_q, ier_rto_q, ier_pe_q, ier_fe_q, ier_rxoe_q, ier_txe_q, ier_rxne_q};
+    UART_ISR:  mem_read_data_d = {21'b0, isr_cm_q, isr_adm_q, isr_brk_q, isr_rxdc_q, isr_txdc_q, isr_rto_q, isr_pe_q, isr_fe_q, isr_rxoe_q, isr_txe, isr_rxne};
     default:   mem_read_data_d = '0;
   endcase
 
+  // The measured baud rate is loaded at the end of the synchronization
+  // character and the auto-baud mode is left
+  if(ab_done) begin
+    cr_acc_incr_d = ab_acc_incr[23:8];
+    cr_acc_frac_d = ab_acc_incr[7:0];
+    cr_abe_d = 0;
+  end
+
+  // The shadowed value is applied once both frontends are between frames
+  cr_load = cr_apply;
+  cr_load_data = cr_shadow_q;
+  if(cr_apply) begin
+    cr_pending_d = 0;
+  end
+
   // Set the register data for write requests
   if(mem_write) begin
-    case(mem_addr[4:2])
+    case(mem_addr[7:2])
       UART_CR: begin
-        cr_acc_incr_d = mem_write_data[31:16];
-        cr_ds_d = mem_write_data[3];
-        cr_s_d = mem_write_data[2];
-        cr_p_d = mem_write_data[1:0];
+        // In shadowed mode, the written value waits for the next frame
+        // boundary instead of resetting the frontends
+        if(cr2_shd_q) begin
+          cr_shadow_d = mem_write_data;
+          cr_pending_d = 1;
+        end else begin
+          cr_load = 1;
+          cr_load_data = mem_write_data;
+          cr_pending_d = 0;
+        end
+      end
+      UART_CR2: begin
+        cr2_msk_d = mem_write_data[31:24];
+        cr2_add_d = mem_write_data[23:16];
+        cr2_brkl_d = mem_write_data[15:8];
+        cr2_mpe_d = mem_write_data[6];
+        cr2_sbk_d = mem_write_data[5];
+        // The streaming and DMA fields are reserved without DMA support
+        cr2_txse_d = DMA_ENABLE && mem_write_data[4];
+        cr2_rxse_d = DMA_ENABLE && mem_write_data[3];
+        cr2_txdmae_d = DMA_ENABLE && mem_write_data[2];
+        cr2_rxdmae_d = DMA_ENABLE && mem_write_data[1];
+        cr2_shd_d = mem_write_data[0];
+      end
+      UART_IER: begin
+        ier_cm_d = mem_write_data[10];
+        ier_adm_d = mem_write_data[9];
+        ier_brk_d = mem_write_data[8];
+        ier_rxdc_d = mem_write_data[7];
+        ier_txdc_d = mem_write_data[6];
+        ier_rto_d = mem_write_data[5];
+        ier_pe_d = mem_write_data[4];
+        ier_fe_d = mem_write_data[3];
+        ier_rxoe_d = mem_write_data[2];
+        ier_txe_d = mem_write_data[1];
+        ier_rxne_d = mem_write_data[0];
       end
-      UART_TXDR: begin
-        txdr_txd_d = mem_write_data[7:0];
+      UART_ISR: begin
+        // Pending error interrupts are cleared by writing 1
+        isr_cm_d = isr_cm_q & ~mem_write_data[10];
+        isr_adm_d = isr_adm_q & ~mem_write_data[9];
+        isr_brk_d = isr_brk_q & ~mem_write_data[8];
+        isr_rxdc_d = isr_rxdc_q & ~mem_write_data[7];
+        isr_txdc_d = isr_txdc_q & ~mem_write_data[6];
+        isr_rto_d = isr_rto_q & ~mem_write_data[5];
+        isr_pe_d = isr_pe_q & ~mem_write_data[4];
+        isr_fe_d = isr_fe_q & ~mem_write_data[3];
+        isr_rxoe_d = isr_rxoe_q & ~mem_write_data[2];
+      end
+      UART_RTOR: begin
+        rtor_rto_d = mem_write_data[7:0];
+      end
+      UART_DER: begin
+        der_dedt_d = mem_write_data[23:16];
+        der_deat_d = mem_write_data[15:8];
+        der_dem_d = mem_write_data[0];
+      end
+      UART_CR3: begin
+        cr3_lme_d = mem_write_data[1];
+        cr3_lbe_d = mem_write_data[0];
+      end
+      UART_CMR: begin
+        cmr_cme1_d = mem_write_data[17];
+        cmr_cme0_d = mem_write_data[16];
+        cmr_chr1_d = mem_write_data[15:8];
+        cmr_chr0_d = mem_write_data[7:0];
+      end
+      UART_CRCCR: begin
+        crccr_ref_d = mem_write_data[3];
+        crccr_w32_d = mem_write_data[2];
+        crccr_rxce_d = mem_write_data[1];
+        crccr_txce_d = mem_write_data[0];
+      end
+      UART_CRCPR: begin
+        crcpr_poly_d = mem_write_data;
+      end
+      UART_CRCIR: begin
+        crcir_init_d = mem_write_data;
+      end
+      UART_FSCR: begin
+        // The counter is cleared by any write
+        fscr_cnt_d = '0;
       end
       default: begin end
     endcase 
   end
 
-  // Priority to the memory request
-  if(mem_write && (mem_addr[4:2] == UART_TXDR)) begin
-    sr_txe_d = 0;
-  end else if (tx_done) begin
-    sr_txe_d = 1;
+  if(cr_load) begin
+    cr_acc_incr_d = cr_load_data[31:16];
+    cr_acc_frac_d = cr_load_data[15:8];
+    cr_rtse_d = cr_load_data[7];
+    cr_ctse_d = cr_load_data[6];
+    cr_abe_d = cr_load_data[5];
+    cr_ovs_d = cr_load_data[4];
+    cr_ds_d = cr_load_data[3];
+    cr_s_d = cr_load_data[2];
+    cr_p_d = cr_load_data[1:0];
+  end
+
+  // Data written to UART_TXDR is queued in the fifo as a single byte along
+  // with its address mark while data written to UART_TXPDR is queued along
+  // with its selected byte lanes.
+  // The data is dropped if the fifo is full or fed by the transmit stream.
+  tx_fifo_cpu_write = 0;
+  tx_fifo_cpu_wdata = {mem_write_data[8], 4'b0001, mem_write_data};
+  if(mem_write && !cr2_txse_q) begin
+    if(mem_addr[7:2] == UART_TXDR) begin
+      tx_fifo_cpu_write = 1;
+    end else if((mem_addr[7:2] == UART_TXPDR) && (mem_sel != '0)) begin
+      tx_fifo_cpu_write = 1;
+      tx_fifo_cpu_wdata = {1'b0, mem_sel, mem_write_data};
+    end
+  end
+
+  // Received frames are pushed to the fifo and reading UART_RXDR
+  // pops its head. Reading UART_RXPDR pops up to three entries, the
+  // number of valid byte lanes being returned by the same read.
+  // Both can happen during the same cycle.
+  // Received frames are not queued when sent on the receive stream.
+  rx_fifo_write = rx_valid && !cr2_rxse_q;
+  rx_fifo_cpu_read = 0;
+  if(mem_read) begin
+    if(mem_addr[7:2] == UART_RXDR) begin
+      rx_fifo_cpu_read = 1;
+    end else if(mem_addr[7:2] == UART_RXPDR) begin
+      rx_fifo_cpu_read = 3;
+    end
   end
 
   // Priority to the hardware
+  rx_overrun = 0;
   if(rx_valid) begin
-    rxdr_rxd_d = rx_frame[7:0];
-    sr_rxne_d = 1;
-
     // Errors accumulate so they are never lost
     sr_pe_d = sr_pe_q | rx_parity_err;
     sr_fe_d = sr_fe_q | rx_frame_err;
+    sr_nf_d = sr_nf_q | rx_noise_err;
+    sr_brk_d = sr_brk_q | rx_break;
     
-    // If data was read but the buffer was already full
-    if (sr_rxne_q) begin
+    // If data was received but the fifo was already full, the received
+    // data is dropped. A simultaneous read frees an entry for it.
+    // On the receive stream, the data is dropped if the previous frame
+    // is still not accepted.
+    if(cr2_rxse_q) begin
+      rx_overrun = stream_rx_valid_q && !stream_rx_ready_i;
+    end else begin
+      rx_overrun = rx_fifo_full && (rx_fifo_cpu_read == '0);
+    end
+    if (rx_overrun) begin
       sr_rxoe_d = 1;
     end
-  // When the memory request occurs but no data was received
-  // we clear the previously received data
-  end else if(mem_read && mem_addr[4:2] == UART_RXDR) begin
-    rxdr_rxd_d = '0;
-    sr_rxne_d = 0;
+
+    // Priority to the hardware over the interrupt acknowledge
+    isr_pe_d = isr_pe_d | rx_parity_err;
+    isr_fe_d = isr_fe_d | rx_frame_err;
+    isr_rxoe_d = isr_rxoe_d | rx_overrun;
+    isr_brk_d = isr_brk_d | rx_break;
   // When the memory request occurs but no data was received
   // we clear the errors
-  end else if(mem_read && mem_addr[4:2] == UART_SR) begin
+  end else if(mem_read && mem_addr[7:2] == UART_SR) begin
     sr_pe_d = 0;
     sr_fe_d = 0;
+    sr_nf_d = 0;
+    sr_brk_d = 0;
     sr_rxoe_d = 0;
   end
+
+  // Rejected start bits are counted, the counter saturating at its maximum.
+  // A start bit rejected while the counter is cleared is not lost.
+  if(rx_false_start && (fscr_cnt_d != '1)) begin
+    fscr_cnt_d = fscr_cnt_d + 1;
+  end
+
+  // The receiver timeout can only occur while no frame is being received
+  if(rx_timeout) begin
+    sr_rto_d = 1;
+    isr_rto_d = 1;
+  end else if(mem_read && mem_addr[7:2] == UART_SR) begin
+    sr_rto_d = 0;
+  end
+
+  // A matching address frame selects the node in multiprocessor mode
+  if(rx_addr_match) begin
+    sr_adm_d = 1;
+    isr_adm_d = 1;
+  end else if(mem_read && mem_addr[7:2] == UART_SR) begin
+    sr_adm_d = 0;
+  end
+
+  // A received match character is flagged so that the software can be
+  // woken once per message
+  if(rx_char_match) begin
+    sr_cmf_d = 1;
+    isr_cm_d = 1;
+  end else if(mem_read && mem_addr[7:2] == UART_SR) begin
+    sr_cmf_d = 0;
+  end
+
+  // Priority to the hardware over the interrupt acknowledge
+  if(dma_tx_done) begin
+    isr_txdc_d = 1;
+  end
+  if(dma_rx_done) begin
+    isr_rxdc_d = 1;
+  end
+
+  // The send break request is cleared by the hardware once the break is sent
+  if(tx_break_done) begin
+    cr2_sbk_d = 0;
+  end
+end
+
+always_comb begin : character_match
+  // Breaks are never matched. With 7 data bits, the eighth bit of the
+  // match characters is ignored.
+  data_mask = cr_ds_q ? 8'hFF : 8'h7F;
+  rx_char_match = rx_valid && !rx_break && (
+      (cmr_cme0_q && (((rx_frame[7:0] ^ cmr_chr0_q) & data_mask) == '0))
+   || (cmr_cme1_q && (((rx_frame[7:0] ^ cmr_chr1_q) & data_mask) == '0)));
+end
+
+always_comb begin : crc_interface
+  // The CRCs are loaded with the init value by any write to their register
+  tx_crc_clear = mem_write && (mem_addr[7:2] == UART_TXCRCR);
+  rx_crc_clear = mem_write && (mem_addr[7:2] == UART_RXCRCR);
+
+  // Bytes are accumulated when consumed by the transmit frontend and when
+  // output by the receive frontend, whether they are queued or dropped.
+  // Breaks are not accumulated.
+  tx_crc_valid = crccr_txce_q && tx_transmit && tx_ready;
+  rx_crc_valid = crccr_rxce_q && rx_valid && !rx_break;
+end
+
+always_comb begin : statistics
+  rxfcr_cnt_d = rxfcr_cnt_q;
+  pecr_cnt_d  = pecr_cnt_q;
+  fecr_cnt_d  = fecr_cnt_q;
+  oecr_cnt_d  = oecr_cnt_q;
+  fstcr_cnt_d = fstcr_cnt_q;
+
+  stat_txf_d = stat_txf_q;
+  stat_rxf_d = stat_rxf_q;
+  stat_pe_d  = stat_pe_q;
+  stat_fe_d  = stat_fe_q;
+  stat_oe_d  = stat_oe_q;
+  stat_fs_d  = stat_fs_q;
+
+  // The stop bits following a break also assert tx_done, the break is
+  // therefore remembered so that it is not counted as a frame
+  stat_brk_d = stat_brk_q;
+  if(tx_break_done) begin
+    stat_brk_d = 1;
+  end else if(tx_start) begin
+    stat_brk_d = 0;
+  end
+
+  // Reading UART_TXFCR returns the live transmit count and captures the
+  // other counters so that they can be read as a consistent sample. All
+  // the counters are then restarted, an event occurring during the same
+  // cycle being accounted to the next sample.
+  stat_snap = mem_read && (mem_addr[7:2] == UART_TXFCR);
+  if(stat_snap) begin
+    rxfcr_cnt_d = stat_rxf_q;
+    pecr_cnt_d  = stat_pe_q;
+    fecr_cnt_d  = stat_fe_q;
+    oecr_cnt_d  = stat_oe_q;
+    fstcr_cnt_d = stat_fs_q;
+
+    stat_txf_d = '0;
+    stat_rxf_d = '0;
+    stat_pe_d  = '0;
+    stat_fe_d  = '0;
+    stat_oe_d  = '0;
+    stat_fs_d  = '0;
+  end
+
+  // The counters saturate at their maximum value. Breaks are not frames
+  // and are therefore never counted.
+  if(tx_done && !stat_brk_q && (stat_txf_d != '1)) begin
+    stat_txf_d = stat_txf_d + 1;
+  end
+  if(rx_valid && !rx_break && (stat_rxf_d != '1)) begin
+    stat_rxf_d = stat_rxf_d + 1;
+  end
+  if(rx_valid && !rx_break && rx_parity_err && (stat_pe_d != '1)) begin
+    stat_pe_d = stat_pe_d + 1;
+  end
+  if(rx_valid && !rx_break && rx_frame_err && (stat_fe_d != '1)) begin
+    stat_fe_d = stat_fe_d + 1;
+  end
+  if(rx_overrun && (stat_oe_d != '1)) begin
+    stat_oe_d = stat_oe_d + 1;
+  end
+  if(rx_false_start && (stat_fs_d != '1)) begin
+    stat_fs_d = stat_fs_d + 1;
+  end
+end
+
+always_comb begin : timestamps
+  // The counter wraps around at its maximum value
+  ts_cnt_d = ts_cnt_q + 1;
+
+  // Received frames are timestamped when pushed to the receive fifo and
+  // transmitted frames when their start bit is output
+  txtsr_ts_d = txtsr_ts_q;
+  if(tx_start) begin
+    txtsr_ts_d = ts_cnt_q;
+  end
+end
+
+always_comb begin : interrupt
+  // Fifo interrupts are pending as long as the condition holds
+  isr_txe = sr_txe;
+  isr_rxne = sr_rxne;
+
+  irq_d = (ier_cm_q   & isr_cm_q)
+        | (ier_adm_q  & isr_adm_q)
+        | (ier_brk_q  & isr_brk_q)
+        | (ier_rxdc_q & isr_rxdc_q)
+        | (ier_txdc_q & isr_txdc_q)
+        | (ier_rto_q  & isr_rto_q)
+        | (ier_pe_q   & isr_pe_q)
+        | (ier_fe_q   & isr_fe_q)
+        | (ier_rxoe_q & isr_rxoe_q)
+        | (ier_txe_q  & isr_txe)
+        | (ier_rxne_q & isr_rxne);
 end
 
 always_comb begin : frontend_interface
-  // Reset the frontends after either a reset or a write to UART_CR
-  frontend_rst = rst_i || (mem_write && mem_addr[4:2] == UART_CR);
+  // Reset the frontends after either a reset or a write to UART_CR, unless
+  // the write is shadowed. They are held in reset while the baud rate is
+  // being measured.
+  cr_write_rst = mem_write && (mem_addr[7:2] == UART_CR) && !cr2_shd_q;
+  autobaud_rst = rst_i || cr_write_rst || cr_apply;
+  frontend_rst = rst_i || cr_write_rst || cr_abe_q;
+
+  // A shadowed UART_CR value is applied when the transmitter reaches the
+  // end of its frame while the receiver is not receiving a frame. The
+  // driver enable guard time after the frame is not cut short.
+  cr_apply = cr_pending_q && tx_ready && rx_idle && !(der_dem_q && tx_de);
 
-  // Transmit after a write to UART_TXDR
-  tx_transmit_d = mem_write && (mem_addr[4:2] == UART_TXDR);
+  // Number of bits between the start bit and the stop bits
+  ab_frame_bits = 4'd7 + {3'b0, cr_ds_q} + {3'b0, (cr_p_q != '0) || cr2_mpe_q};
+
+  // The byte lanes of the fifo head are sent from the lowest to the highest
+  tx_lanes = tx_fifo_data[35:32] & ~tx_consumed_q;
+  tx_lane = tx_lanes & (~tx_lanes + 1);
+  tx_data = ({8{tx_lane[0]}} & tx_fifo_data[7:0])
+          | ({8{tx_lane[1]}} & tx_fifo_data[15:8])
+          | ({8{tx_lane[2]}} & tx_fifo_data[23:16])
+          | ({8{tx_lane[3]}} & tx_fifo_data[31:24]);
+  // Only single byte entries hold an address mark
+  tx_mark = tx_fifo_data[36];
+
+  // The head of the fifo is presented to the frontend as long as the fifo
+  // holds data. It is consumed when the frontend is ready, either when idle
+  // or at the end of the previous frame.
+  // When CTS is deasserted, the frame being sent is completed but the next
+  // one is held.
+  // The next frame is also held while a shadowed UART_CR value is pending.
+  // CTS is ignored in loopback mode as no remote receiver is involved.
+  // The frames are held as long as the pin echoes the receive input.
+  tx_transmit = !tx_fifo_empty && !frontend_rst && !(cr_ctse_q && uart_cts_qq && !cr3_lbe_q) && !cr_pending_q && !line_echo;
+
+  // The fifo head is only popped once its last byte lane is consumed
+  tx_consumed_d = tx_consumed_q;
+  tx_fifo_read = 0;
+  if(tx_transmit && tx_ready) begin
+    if(tx_lanes == tx_lane) begin
+      tx_fifo_read = 1;
+      tx_consumed_d = '0;
+    end else begin
+      tx_consumed_d = tx_consumed_q | tx_lane;
+    end
+  end
+end
+
+always_comb begin : dma_interface
+  // The DMA master accesses the fifos when the processor does not. It does
+  // not pop the receive fifo while a frame is pushed so that the overrun
+  // detection is not affected.
+  // The transmit fifo is only fed by the transmit stream when enabled.
+  dma_tx_fifo_ready = !tx_fifo_full && !tx_fifo_cpu_write && !cr2_txse_q;
+  dma_rx_fifo_ready = (rx_fifo_cpu_read == '0) && !rx_valid;
+
+  tx_fifo_write = tx_fifo_cpu_write || dma_tx_fifo_write || stream_tx_write;
+  if(cr2_txse_q) begin
+    tx_fifo_wdata = {1'b0, 4'b0001, 24'b0, stream_tx_data_i};
+  end else if(tx_fifo_cpu_write) begin
+    tx_fifo_wdata = tx_fifo_cpu_wdata;
+  end else begin
+    tx_fifo_wdata = {1'b0, dma_tx_fifo_wdata};
+  end
+  rx_fifo_read = (rx_fifo_cpu_read != '0) ? rx_fifo_cpu_read : dma_rx_fifo_read;
+end
+
+generate
+  if(DMA_ENABLE) begin : gen_streaming
+    always_comb begin : streaming
+      // A byte of the transmit stream is queued in the transmit fifo as soon
+      // as it has room
+      stream_tx_ready = cr2_txse_q && !tx_fifo_full;
+      stream_tx_write = stream_tx_valid_i && stream_tx_ready;
+
+      // Received frames are held on the receive stream until accepted, along
+      // with their errors. A frame received while the previous one is held
+      // is dropped.
+      stream_rx_valid_d = stream_rx_valid_q && !stream_rx_ready_i;
+      stream_rx_data_d = stream_rx_data_q;
+      stream_rx_err_d = stream_rx_err_q;
+      if(cr2_rxse_q && rx_valid && !stream_rx_valid_d) begin
+        stream_rx_valid_d = 1;
+        stream_rx_data_d = rx_frame[7:0];
+        stream_rx_err_d = {rx_noise_err, rx_frame_err, rx_parity_err};
+      end
+    end
+  end else begin : gen_no_streaming
+    // No byte is accepted nor output
+    assign stream_tx_ready = 0;
+    assign stream_tx_write = 0;
+    assign stream_rx_valid_d = 0;
+    assign stream_rx_data_d = '0;
+    assign stream_rx_err_d = '0;
+  end
+endgenerate
+
+always_comb begin : loopback
+  // The receiver is fed by the transmitter in loopback mode, the pins
+  // being held idle. In line monitor mode, the receiver keeps sampling the
+  // pin while the received line is echoed back on the transmit pin so that
+  // the remote end can check the whole path. The loopback mode takes
+  // precedence.
+  rx_serial = cr3_lbe_q ? tx_serial : uart_rx_i;
+  line_echo = cr3_lme_q && !cr3_lbe_q;
+end
+
+always_comb begin : flow_control
+  // RTS is deasserted when the receive fifo is about to be full so that
+  // the remote transmitter stops after its current frame
+  uart_rts_d = cr_rtse_q && (rx_fifo_count >= RX_CNT_WIDTH'(RTS_LEVEL));
 end
 
+generate
+  if(DMA_ENABLE) begin : gen_dma_requests
+    always_comb begin : dma_requests
+      // A request is held as long as its condition holds. It is dropped for a
+      // cycle after each acknowledge so that the condition is evaluated again
+      // once the fifo was updated by the transfer.
+      dma_rx_req_d = cr2_rxdmae_q && !rx_fifo_empty && !dma_rx_ack_i;
+      dma_tx_req_d = cr2_txdmae_q && !tx_fifo_full && !dma_tx_ack_i;
+    end
+  end else begin : gen_no_dma_requests
+    assign dma_rx_req_d = 0;
+    assign dma_tx_req_d = 0;
+  end
+endgenerate
+
 always_ff @(posedge clk_i) begin
   if(rst_i) begin
     cr_acc_incr_q <= '0;
+    cr_acc_frac_q <= '0;
+    cr_rtse_q <= 0;
+    cr_ctse_q <= 0;
+    cr_abe_q <= 0;
+    cr_ovs_q <= 0;
     cr_ds_q <= 0;
     cr_s_q <= 0;
     cr_p_q <= '0;
 
+    cr_shadow_q <= '0;
+    cr_pending_q <= 0;
+
+    cr2_txse_q <= 0;
+    cr2_rxse_q <= 0;
+    cr2_txdmae_q <= 0;
+    cr2_rxdmae_q <= 0;
+    cr2_shd_q <= 0;
+    cr2_sbk_q <= 0;
+    cr2_brkl_q <= '0;
+    cr2_mpe_q <= 0;
+    cr2_add_q <= '0;
+    cr2_msk_q <= '0;
+
+    rtor_rto_q <= '0;
+
+    der_dem_q <= 0;
+    der_deat_q <= '0;
+    der_dedt_q <= '0;
+
+    cr3_lme_q <= 0;
+    cr3_lbe_q <= 0;
+
+    crccr_ref_q <= 0;
+    crccr_w32_q <= 0;
+    crccr_rxce_q <= 0;
+    crccr_txce_q <= 0;
+    crcpr_poly_q <= '0;
+    crcir_init_q <= '0;
+
+    cmr_cme1_q <= 0;
+    cmr_cme0_q <= 0;
+    cmr_chr1_q <= '0;
+    cmr_chr0_q <= '0;
+
+    fscr_cnt_q <= '0;
+
+    stat_txf_q <= '0;
+    stat_rxf_q <= '0;
+    stat_pe_q <= '0;
+    stat_fe_q <= '0;
+    stat_oe_q <= '0;
+    stat_fs_q <= '0;
+    stat_brk_q <= 0;
+
+    rxfcr_cnt_q <= '0;
+    pecr_cnt_q <= '0;
+    fecr_cnt_q <= '0;
+    oecr_cnt_q <= '0;
+    fstcr_cnt_q <= '0;
+
+    ts_cnt_q <= '0;
+    txtsr_ts_q <= '0;
+
+    sr_cmf_q <= 0;
+    sr_adm_q <= 0;
+    sr_brk_q <= 0;
+    sr_nf_q <= 0;
+    sr_rto_q <= 0;
     sr_pe_q <= 0;
     sr_fe_q <= 0;
     sr_rxoe_q <= 0;
-    sr_txe_q <= 1;
-    sr_rxne_q <= 0;
 
-    rxdr_rxd_q <= '0;
-    txdr_txd_q <= '0;
+    ier_cm_q <= 0;
+    ier_adm_q <= 0;
+    ier_brk_q <= 0;
+    ier_rxdc_q <= 0;
+    ier_txdc_q <= 0;
+    ier_rto_q <= 0;
+    ier_pe_q <= 0;
+    ier_fe_q <= 0;
+    ier_rxoe_q <= 0;
+    ier_txe_q <= 0;
+    ier_rxne_q <= 0;
+
+    isr_cm_q <= 0;
+    isr_adm_q <= 0;
+    isr_brk_q <= 0;
+    isr_rxdc_q <= 0;
+    isr_txdc_q <= 0;
+    isr_rto_q <= 0;
+    isr_pe_q <= 0;
+    isr_fe_q <= 0;
+    isr_rxoe_q <= 0;
+
+    irq_q <= 0;
+
+    tx_consumed_q <= '0;
+
+    uart_cts_q <= 1;
+    uart_cts_qq <= 1;
+    uart_echo_q <= 1;
+    uart_echo_qq <= 1;
+    uart_rts_q <= 0;
+
+    dma_rx_req_q <= 0;
+    dma_tx_req_q <= 0;
 
-    tx_transmit_q <= 0;
+    stream_rx_valid_q <= 0;
+    stream_rx_data_q <= '0;
+    stream_rx_err_q <= '0;
 
     mem_read_data_q <= '0;
   end else begin
     cr_acc_incr_q <= cr_acc_incr_d;
+    cr_acc_frac_q <= cr_acc_frac_d;
+    cr_rtse_q <= cr_rtse_d;
+    cr_ctse_q <= cr_ctse_d;
+    cr_abe_q <= cr_abe_d;
+    cr_ovs_q <= cr_ovs_d;
     cr_ds_q <= cr_ds_d;
     cr_s_q <= cr_s_d;
     cr_p_q <= cr_p_d;
 
+    cr_shadow_q <= cr_shadow_d;
+    cr_pending_q <= cr_pending_d;
+
+    cr2_txse_q <= cr2_txse_d;
+    cr2_rxse_q <= cr2_rxse_d;
+    cr2_txdmae_q <= cr2_txdmae_d;
+    cr2_rxdmae_q <= cr2_rxdmae_d;
+    cr2_shd_q <= cr2_shd_d;
+    cr2_sbk_q <= cr2_sbk_d;
+    cr2_brkl_q <= cr2_brkl_d;
+    cr2_mpe_q <= cr2_mpe_d;
+    cr2_add_q <= cr2_add_d;
+    cr2_msk_q <= cr2_msk_d;
+
+    rtor_rto_q <= rtor_rto_d;
+
+    der_dem_q <= der_dem_d;
+    der_deat_q <= der_deat_d;
+    der_dedt_q <= der_dedt_d;
+
+    cr3_lme_q <= cr3_lme_d;
+    cr3_lbe_q <= cr3_lbe_d;
+
+    crccr_ref_q <= crccr_ref_d;
+    crccr_w32_q <= crccr_w32_d;
+    crccr_rxce_q <= crccr_rxce_d;
+    crccr_txce_q <= crccr_txce_d;
+    crcpr_poly_q <= crcpr_poly_d;
+    crcir_init_q <= crcir_init_d;
+
+    cmr_cme1_q <= cmr_cme1_d;
+    cmr_cme0_q <= cmr_cme0_d;
+    cmr_chr1_q <= cmr_chr1_d;
+    cmr_chr0_q <= cmr_chr0_d;
+
+    fscr_cnt_q <= fscr_cnt_d;
+
+    stat_txf_q <= stat_txf_d;
+    stat_rxf_q <= stat_rxf_d;
+    stat_pe_q <= stat_pe_d;
+    stat_fe_q <= stat_fe_d;
+    stat_oe_q <= stat_oe_d;
+    stat_fs_q <= stat_fs_d;
+    stat_brk_q <= stat_brk_d;
+
+    rxfcr_cnt_q <= rxfcr_cnt_d;
+    pecr_cnt_q <= pecr_cnt_d;
+    fecr_cnt_q <= fecr_cnt_d;
+    oecr_cnt_q <= oecr_cnt_d;
+    fstcr_cnt_q <= fstcr_cnt_d;
+
+    ts_cnt_q <= ts_cnt_d;
+    txtsr_ts_q <= txtsr_ts_d;
+
+    sr_cmf_q <= sr_cmf_d;
+    sr_adm_q <= sr_adm_d;
+    sr_brk_q <= sr_brk_d;
+    sr_nf_q <= sr_nf_d;
+    sr_rto_q <= sr_rto_d;
     sr_pe_q <= sr_pe_d;
     sr_fe_q <= sr_fe_d;
     sr_rxoe_q <= sr_rxoe_d;
-    sr_txe_q <= sr_txe_d;
-    sr_rxne_q <= sr_rxne_d;
 
-    rxdr_rxd_q <= rxdr_rxd_d;
-    txdr_txd_q <= txdr_txd_d;
+    ier_cm_q <= ier_cm_d;
+    ier_adm_q <= ier_adm_d;
+    ier_brk_q <= ier_brk_d;
+    ier_rxdc_q <= ier_rxdc_d;
+    ier_txdc_q <= ier_txdc_d;
+    ier_rto_q <= ier_rto_d;
+    ier_pe_q <= ier_pe_d;
+    ier_fe_q <= ier_fe_d;
+    ier_rxoe_q <= ier_rxoe_d;
+    ier_txe_q <= ier_txe_d;
+    ier_rxne_q <= ier_rxne_d;
+
+    isr_cm_q <= isr_cm_d;
+    isr_adm_q <= isr_adm_d;
+    isr_brk_q <= isr_brk_d;
+    isr_rxdc_q <= isr_rxdc_d;
+    isr_txdc_q <= isr_txdc_d;
+    isr_rto_q <= isr_rto_d;
+    isr_pe_q <= isr_pe_d;
+    isr_fe_q <= isr_fe_d;
+    isr_rxoe_q <= isr_rxoe_d;
+
+    irq_q <= irq_d;
+
+    tx_consumed_q <= tx_consumed_d;
 
-    tx_transmit_q <= tx_transmit_d;
+    // Two-flop synchronizer for the clear to send input
+    uart_cts_q <= uart_cts_i;
+    uart_cts_qq <= uart_cts_q;
+
+    // The echoed receive input is registered twice as well
+    uart_echo_q <= uart_rx_i;
+    uart_echo_qq <= uart_echo_q;
+    uart_rts_q <= uart_rts_d;
+
+    dma_rx_req_q <= dma_rx_req_d;
+    dma_tx_req_q <= dma_tx_req_d;
+
+    stream_rx_valid_q <= stream_rx_valid_d;
+    stream_rx_data_q <= stream_rx_data_d;
+    stream_rx_err_q <= stream_rx_err_d;
 
     mem_read_data_q <= mem_read_data_d;
   end
 end
 
+/*****************************************/
+/*         Assign output signals         */
+/*****************************************/
+
+assign irq_o = irq_q;
+assign reg_read_data_o = mem_read_data_q;
+assign uart_rts_o = uart_rts_q;
+assign uart_tx_o = line_echo ? uart_echo_qq : (tx_serial | cr3_lbe_q);
+assign uart_de_o = der_dem_q && tx_de && !cr3_lbe_q;
+assign dma_rx_req_o = dma_rx_req_q;
+assign dma_tx_req_o = dma_tx_req_q;
+assign stream_tx_ready_o = stream_tx_ready;
+assign stream_rx_valid_o = stream_rx_valid_q;
+assign stream_rx_data_o = stream_rx_data_q;
+assign stream_rx_err_o = stream_rx_err_q;
+
 endmodule // ecap5_dwbuart
@@ -0,0 +1,254 @@
+/*           __        _
+ *  ________/ /  ___ _(_)__  ___
+ * / __/ __/ _ \/ _ `/ / _ \/ -_)
+ * \__/\__/_//_/\_,_/_/_//_/\__/
+ *
+ * Copyright (C) Clément Chaine
+ * This file is part of ECAP5-DWBUART <https://github.com/ecap5/ECAP5-DWBUART>
+ *
+ * ECAP5-DWBUART is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ECAP5-DWBUART is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ECAP5-DWBUART.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+module ecap5_dwbuart_array #(
+  // Number of UART channels, up to 32
+  parameter int NUM_CHANNELS  = 4,
+  // Number of received frames buffered by each channel
+  parameter int RX_FIFO_DEPTH = 16,
+  // Number of frames queued for transmission by each channel
+  parameter int TX_FIFO_DEPTH = 16,
+
+  // Each channel has a 256-byte register bank, the first bank holding the
+  // registers shared by all channels
+  localparam int BANK_WIDTH = $clog2(NUM_CHANNELS + 1),
+
+  localparam logic[5:0] UART_CHISR = 0,
+  localparam logic[5:0] UART_CHIER = 1
+)(
+  input   logic         clk_i,
+  input   logic         rst_i,
+
+  output  logic         irq_o,
+
+  //=================================
+  //    Memory interface
+
+  input   logic[31:0]  wb_adr_i,
+  output  logic[31:0]  wb_dat_o,
+  input   logic[31:0]  wb_dat_i,
+  input   logic        wb_we_i,
+  input   logic[3:0]   wb_sel_i,
+  input   logic        wb_stb_i,
+  output  logic        wb_ack_o,
+  input   logic        wb_cyc_i,
+  output  logic        wb_stall_o,
+
+  //=================================
+  //    Serial interface
+  
+  input  logic[NUM_CHANNELS-1:0] uart_rx_i,
+  output logic[NUM_CHANNELS-1:0] uart_tx_o,
+  output logic[NUM_CHANNELS-1:0] uart_de_o,
+
+  //=================================
+  //    Flow control interface
+
+  input  logic[NUM_CHANNELS-1:0] uart_cts_i,
+  output logic[NUM_CHANNELS-1:0] uart_rts_o
+);
+
+/*****************************************/
+/*           Internal signals            */
+/*****************************************/
+
+logic[31:0] mem_addr;
+logic       mem_read, mem_write;
+logic[31:0] mem_read_data,
+            mem_write_data;
+logic[3:0]  mem_sel;
+
+// Register bank targeted by the current access, registered along with the
+// read data of the channels
+logic[BANK_WIDTH-1:0] bank;
+logic[BANK_WIDTH-1:0] bank_d, bank_q;
+
+logic[NUM_CHANNELS-1:0] ch_read, ch_write;
+logic[31:0]             ch_read_data[NUM_CHANNELS];
+logic[NUM_CHANNELS-1:0] ch_irq;
+
+/*****************************************/
+/*        Memory mapped registers        */
+/*****************************************/
+
+logic[NUM_CHANNELS-1:0] chier_d, chier_q;
+
+logic[31:0] shared_read_data_d, shared_read_data_q;
+
+/*****************************************/
+/*            Output signals             */
+/*****************************************/
+
+logic irq_d, irq_q;
+
+/*****************************************/
+
+ecap5_dwbmmsc wb_interface_inst (
+  .clk_i (clk_i),   .rst_i (rst_i),
+  
+  .wb_adr_i (wb_adr_i),  .wb_dat_o (wb_dat_o),  .wb_dat_i   (wb_dat_i),
+  .wb_we_i  (wb_we_i),   .wb_sel_i (wb_sel_i),  .wb_stb_i   (wb_stb_i),
+  .wb_ack_o (wb_ack_o),  .wb_cyc_i (wb_cyc_i),  .wb_stall_o (wb_stall_o),
+
+  .addr_o       (mem_addr),
+  .read_o       (mem_read),
+  .read_data_i  (mem_read_data),
+  .write_o      (mem_write),
+  .write_data_o (mem_write_data),
+  .sel_o        (mem_sel)
+);
+
+for(genvar i = 0; i < NUM_CHANNELS; i++) begin : gen_channel
+  ecap5_dwbuart #(
+    .RX_FIFO_DEPTH (RX_FIFO_DEPTH),
+    .TX_FIFO_DEPTH (TX_FIFO_DEPTH),
+    .SHARED_SLAVE  (1),
+    .DMA_ENABLE    (0)
+  ) channel_inst (
+    .clk_i            (clk_i),
+    .rst_i            (rst_i),
+
+    .irq_o            (ch_irq[i]),
+
+    .wb_adr_i         ('0),
+    .wb_dat_o         (),
+    .wb_dat_i         ('0),
+    .wb_we_i          (0),
+    .wb_sel_i         ('0),
+    .wb_stb_i         (0),
+    .wb_ack_o         (),
+    .wb_cyc_i         (0),
+    .wb_stall_o       (),
+
+    .reg_addr_i       (mem_addr),
+    .reg_read_i       (ch_read[i]),
+    .reg_read_data_o  (ch_read_data[i]),
+    .reg_write_i      (ch_write[i]),
+    .reg_write_data_i (mem_write_data),
+    .reg_sel_i        (mem_sel),
+
+    .uart_rx_i        (uart_rx_i[i]),
+    .uart_tx_o        (uart_tx_o[i]),
+    .uart_de_o        (uart_de_o[i]),
+
+    .uart_cts_i       (uart_cts_i[i]),
+    .uart_rts_o       (uart_rts_o[i]),
+
+    // The DMA and streaming interfaces are not available in the array
+    .dma_rx_req_o     (),
+    .dma_rx_ack_i     (0),
+    .dma_tx_req_o     (),
+    .dma_tx_ack_i     (0),
+
+    .wbm_adr_o        (),
+    .wbm_dat_o        (),
+    .wbm_dat_i        ('0),
+    .wbm_we_o         (),
+    .wbm_sel_o        (),
+    .wbm_stb_o        (),
+    .wbm_ack_i        (0),
+    .wbm_cyc_o        (),
+    .wbm_stall_i      (1),
+
+    .stream_tx_valid_i (0),
+    .stream_tx_data_i  ('0),
+    .stream_tx_ready_o (),
+
+    .stream_rx_valid_o (),
+    .stream_rx_data_o  (),
+    .stream_rx_err_o   (),
+    .stream_rx_ready_i (0)
+  );
+end
+
+always_comb begin : address_decoder
+  // A single decoder selects the register bank, the channels only decoding
+  // the offset of their registers
+  bank = mem_addr[8 +: BANK_WIDTH];
+  bank_d = bank;
+
+  for(int i = 0; i < NUM_CHANNELS; i++) begin
+    ch_read[i] = mem_read && (bank == BANK_WIDTH'(i + 1));
+    ch_write[i] = mem_write && (bank == BANK_WIDTH'(i + 1));
+  end
+
+  // The read data of the channels is registered, the bank is therefore
+  // selected from the registered bank
+  if(bank_q == '0) begin
+    mem_read_data = shared_read_data_q;
+  end else if(bank_q <= BANK_WIDTH'(NUM_CHANNELS)) begin
+    mem_read_data = ch_read_data[bank_q - 1];
+  end else begin
+    mem_read_data = '0;
+  end
+end
+
+always_comb begin : register_access
+  chier_d = chier_q;
+
+  // Set the data output for read requests
+  shared_read_data_d = '0;
+  if(bank == '0) begin
+    case(mem_addr[7:2])
+      UART_CHISR: shared_read_data_d = 32'(ch_irq);
+      UART_CHIER: shared_read_data_d = 32'(chier_q);
+      default:    shared_read_data_d = '0;
+    endcase
+  end
+
+  // Set the register data for write requests
+  if(mem_write && (bank == '0)) begin
+    case(mem_addr[7:2])
+      UART_CHIER: begin
+        chier_d = mem_write_data[NUM_CHANNELS-1:0];
+      end
+      default: begin end
+    endcase
+  end
+end
+
+always_comb begin : interrupt
+  // A single interrupt is raised for all the enabled channels
+  irq_d = |(ch_irq & chier_q);
+end
+
+always_ff @(posedge clk_i) begin
+  if(rst_i) begin
+    chier_q <= '0;
+    shared_read_data_q <= '0;
+    bank_q <= '0;
+    irq_q <= 0;
+  end else begin
+    chier_q <= chier_d;
+    shared_read_data_q <= shared_read_data_d;
+    bank_q <= bank_d;
+    irq_q <= irq_d;
+  end
+end
+
+/*****************************************/
+/*         Assign output signals         */
+/*****************************************/
+
+assign irq_o = irq_q;
+
+endmodule // ecap5_dwbuart_array
@@ -0,0 +1,135 @@
+/*           __        _
+ *  ________/ /  ___ _(_)__  ___
+ * / __/ __/ _ \/ _ `/ / _ \/ -_)
+ * \__/\__/_//_/\_,_/_/_//_/\__/
+ *
+ * Copyright (C) Clément Chaine
+ * This file is part of ECAP5-DWBUART <https://github.com/ecap5/ECAP5-DWBUART>
+ *
+ * ECAP5-DWBUART is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ECAP5-DWBUART is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ECAP5-DWBUART.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+module fifo #(
+  parameter int DATA_WIDTH = 8,
+  parameter int DEPTH      = 16,
+  // Maximum number of entries read at once
+  parameter int NUM_READ   = 1,
+  // Number of oldest entries output, up to NUM_READ
+  parameter int NUM_OUT    = NUM_READ,
+
+  localparam int PTR_WIDTH = (DEPTH > 1) ? $clog2(DEPTH) : 1,
+  localparam int CNT_WIDTH = $clog2(DEPTH + 1),
+  localparam int RD_WIDTH  = $clog2(NUM_READ + 1)
+)(
+  input   logic                   clk_i,
+  input   logic                   rst_i,
+
+  input   logic                   write_i,
+  input   logic[DATA_WIDTH-1:0]   data_i,
+
+  input   logic[RD_WIDTH-1:0]               read_i,
+  output  logic[NUM_OUT*DATA_WIDTH-1:0]     data_o,
+
+  output  logic                   empty_o,
+  output  logic                   full_o,
+  output  logic[CNT_WIDTH-1:0]    count_o
+);
+
+/*****************************************/
+/*           Internal signals            */
+/*****************************************/
+
+logic[DATA_WIDTH-1:0] mem_q[DEPTH];
+
+logic[PTR_WIDTH-1:0] wr_ptr_d, wr_ptr_q,
+                     rd_ptr_d, rd_ptr_q;
+logic[CNT_WIDTH-1:0] count_d, count_q;
+
+logic empty, full;
+logic push;
+logic[CNT_WIDTH-1:0] pop_cnt;
+
+logic[PTR_WIDTH-1:0] rd_idx;
+logic[NUM_OUT*DATA_WIDTH-1:0] head;
+
+/*****************************************/
+
+always_comb begin : pointers
+  wr_ptr_d = wr_ptr_q;
+  rd_ptr_d = rd_ptr_q;
+  count_d  = count_q;
+
+  empty = (count_q == '0);
+  full  = (count_q == CNT_WIDTH'(DEPTH));
+
+  // At most the number of stored entries can be read.
+  // A read is performed before the write so that both can happen
+  // during the same cycle, even when the fifo is full
+  pop_cnt = (CNT_WIDTH'(read_i) > count_q) ? count_q : CNT_WIDTH'(read_i);
+  push = write_i && (!full || (pop_cnt != '0));
+
+  if(push) begin
+    // The pointers wrap around explicitly to support non power-of-two depths
+    wr_ptr_d = (wr_ptr_q == PTR_WIDTH'(DEPTH - 1)) ? '0 : wr_ptr_q + 1;
+  end
+  if({1'b0, rd_ptr_q} + (PTR_WIDTH+1)'(pop_cnt) >= (PTR_WIDTH+1)'(DEPTH)) begin
+    rd_ptr_d = PTR_WIDTH'({1'b0, rd_ptr_q} + (PTR_WIDTH+1)'(pop_cnt) - (PTR_WIDTH+1)'(DEPTH));
+  end else begin
+    rd_ptr_d = rd_ptr_q + PTR_WIDTH'(pop_cnt);
+  end
+
+  count_d = count_q + CNT_WIDTH'(push) - pop_cnt;
+end
+
+always_comb begin : head_entries
+  // The NUM_OUT oldest entries are output, unused entries being driven to zero
+  for(int i = 0; i < NUM_OUT; i++) begin
+    if({1'b0, rd_ptr_q} + (PTR_WIDTH+1)'(i) >= (PTR_WIDTH+1)'(DEPTH)) begin
+      rd_idx = PTR_WIDTH'({1'b0, rd_ptr_q} + (PTR_WIDTH+1)'(i) - (PTR_WIDTH+1)'(DEPTH));
+    end else begin
+      rd_idx = rd_ptr_q + PTR_WIDTH'(i);
+    end
+    head[i*DATA_WIDTH +: DATA_WIDTH] = (CNT_WIDTH'(i) < count_q) ? mem_q[rd_idx] : '0;
+  end
+end
+
+always_ff @(posedge clk_i) begin
+  // The storage is not reset so that it can be inferred as distributed ram
+  if(push) begin
+    mem_q[wr_ptr_q] <= data_i;
+  end
+end
+
+always_ff @(posedge clk_i) begin
+  if(rst_i) begin
+    wr_ptr_q <= '0;
+    rd_ptr_q <= '0;
+    count_q  <= '0;
+  end else begin
+    wr_ptr_q <= wr_ptr_d;
+    rd_ptr_q <= rd_ptr_d;
+    count_q  <= count_d;
+  end
+end
+
+/*****************************************/
+/*         Assign output signals         */
+/*****************************************/
+
+assign data_o  = head;
+assign empty_o = empty;
+assign full_o  = full;
+assign count_o = count_q;
+
+endmodule // fifo
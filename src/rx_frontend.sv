@@ -28,16 +28,33 @@ module rx_frontend #(
   input   logic         rst_i,
 
   input   logic[15:0]   cr_acc_incr_i,
+  input   logic[7:0]    cr_acc_frac_i,
   input   logic         cr_ds_i,
   input   logic[1:0]    cr_p_i,
   input   logic         cr_s_i,
+  input   logic         cr_ovs_i,
+
+  // In multiprocessor mode, the parity bit is replaced by an address mark.
+  // Only the frames following an address matching mpe_addr_i on the bits
+  // set in mpe_mask_i are output.
+  input   logic         cr_mpe_i,
+  input   logic[7:0]    mpe_addr_i,
+  input   logic[7:0]    mpe_mask_i,
+
+  input   logic[7:0]    rtor_rto_i,
 
   input   logic         uart_rx_i,
 
   output  logic[10:0]   frame_o,
   output  logic         parity_err_o,
   output  logic         frame_err_o,
-  output  logic         output_valid_o
+  output  logic         noise_err_o,
+  output  logic         break_o,
+  output  logic         output_valid_o,
+  output  logic         addr_match_o,
+  output  logic         false_start_o,
+  output  logic         timeout_o,
+  output  logic         idle_o
 );
 
 /*****************************************/
@@ -53,7 +70,9 @@ state_t state_d, state_q;
 
 logic uart_rx_q, uart_rx_qq, uart_rx_qqq;
 
-logic[16:0] baud_acc_d, baud_acc_q;
+// The baud accumulator is extended with the fractional part of the increment
+logic[23:0] acc_incr;
+logic[24:0] baud_acc_d, baud_acc_q;
 logic baud_acc_half_overflow, baud_acc_overflow;
 
 logic[MAX_FRAME_SIZE:0]  frame_bit_cnt_d, frame_bit_cnt_q;
@@ -63,6 +82,30 @@ logic[$clog2(MAX_FRAME_SIZE)-1:0] frame_start_index;
 logic frame_bit_cnt_done;
 logic data_bit_cnt_done_d, data_bit_cnt_done_q;
 
+// Early and middle samples of the current bit used for the majority vote
+logic[1:0] vote_d, vote_q;
+logic vote_taken_d, vote_taken_q;
+// Asserted between the middle of a bit and its late sample
+logic late_wait_d, late_wait_q;
+logic vote0, vote1;
+// Sampled bit value
+logic sample, sample_noise;
+
+// Asserted after a break until the line goes back high
+logic break_wait_d, break_wait_q;
+logic break_detected;
+
+// Address filtering in multiprocessor mode
+logic[7:0] frame_data;
+logic addr_frame, addr_match;
+logic frame_accepted;
+// Asserted while the frames are addressed to this node
+logic selected_d, selected_q;
+
+// Number of bit times elapsed since the end of the last frame
+logic[7:0] idle_cnt_d, idle_cnt_q;
+logic timeout_armed_d, timeout_armed_q;
+
 /*****************************************/
 /*            Output signals             */
 /*****************************************/
@@ -71,9 +114,14 @@ logic data_bit_cnt_done_d, data_bit_cnt_done_q;
 logic parity_d, parity_q;
 // Received parity
 logic parity_bit;
+// Noise detected during the frame
+logic noise_d, noise_q;
 
 logic[MAX_FRAME_SIZE-1:0] frame_d, frame_q, frame_shifted0, frame_shifted;
 
+logic timeout;
+logic false_start;
+
 /*****************************************/
 
 always_comb begin : state_machine
@@ -82,14 +130,15 @@ always_comb begin : state_machine
   case(state_q)
     IDLE: begin
       // Wait for the beginning of the start bit
-      if(uart_rx_qq == 0) begin
+      if(uart_rx_qq == 0 && !break_wait_q) begin
         state_d = START;
       end
     end
     START: begin
       // Wait for the middle of the start bit
       if(baud_acc_half_overflow) begin
-        state_d = DATA;
+        // The start bit is rejected if the line went back high
+        state_d = false_start ? IDLE : DATA;
       end
     end
     DATA: begin
@@ -107,9 +156,13 @@ always_comb begin : sampling
   frame_bit_cnt_d = frame_bit_cnt_q;
   frame_d = frame_q;
   parity_d = parity_q;
+  noise_d = noise_q;
+  vote_d = vote_q;
+  vote_taken_d = vote_taken_q;
+  late_wait_d = late_wait_q;
 
   // The frame size is computed based on the given configuration
-  frame_size = MIN_FRAME_SIZE + {3'b0, cr_ds_i} + {2'b0, (cr_p_i == '0 ? 1'b0 : 1'b1)} + {3'b0, cr_s_i};
+  frame_size = MIN_FRAME_SIZE + {3'b0, cr_ds_i} + {2'b0, ((cr_p_i == '0) && !cr_mpe_i ? 1'b0 : 1'b1)} + {3'b0, cr_s_i};
   // Index of bit0 in the frame_q shift register
   frame_start_index = MAX_FRAME_SIZE - frame_size;
   // A frame is terminated when this bit is set
@@ -120,44 +173,69 @@ always_comb begin : sampling
   parity_bit = cr_ds_i ? frame_shifted[8] : frame_shifted[7];
 
   // Baudrate accumulator overflow
-  baud_acc_overflow = baud_acc_q[16];
-  baud_acc_half_overflow = baud_acc_q[15];
+  acc_incr = {cr_acc_incr_i, cr_acc_frac_i};
+  baud_acc_overflow = baud_acc_q[24];
+  baud_acc_half_overflow = baud_acc_q[23] | baud_acc_q[24];
+
+  // The start bit is checked again at its middle to filter out glitches
+  false_start = (state_q == START) && baud_acc_half_overflow && uart_rx_qqq;
 
   case(state_q)
     IDLE: begin
+      // The baud interval keeps elapsing after a frame to measure the idle time
+      if(timeout_armed_q) begin
+        baud_acc_d = {1'b0, baud_acc_q[23:0]} + {1'b0, acc_incr};
+      end
       // We initialize the baud_rate counter at the start of the start bit
-      if(uart_rx_qq == 0) begin
-        // This is initialized to (2**15) as we want it to overflow in half the baud period
+      if(uart_rx_qq == 0 && !break_wait_q) begin
+        // This is initialized to (2**23) as we want it to overflow in half the baud period
         // so that we sample in the middle of the bits
-        baud_acc_d = {2'b0, cr_acc_incr_i[14:0]};
+        baud_acc_d = {1'b0, acc_incr};
       end
     end
     START: begin
-      baud_acc_d = {2'b0, baud_acc_q[14:0]} + {2'b0, cr_acc_incr_i[14:0]};
+      baud_acc_d = {2'b0, baud_acc_q[22:0]} + {1'b0, acc_incr};
       // We initialize the data counter when reaching the middle of the start bit
-      // This is reached when the 15th bit is set.
-      if(baud_acc_half_overflow) begin
+      // This is reached when the 23rd bit is set.
+      if(baud_acc_half_overflow && !false_start) begin
         // It takes one cycle for logic to detect this counter is null
         // The counter is therefore initialized to acc_incr (1 cycle)
-        baud_acc_d = {1'b0, cr_acc_incr_i[15:0]};
+        baud_acc_d = {1'b0, acc_incr};
         // Initialize the frame size ring counter
         frame_bit_cnt_d[0] = 1'b1;
         // Initialize the parity bit with the parity configuration bit
         // the parity is still computed when disabled but shall be ignored by the user
         parity_d = cr_p_i[0];
+        noise_d = 0;
+        vote_taken_d = 0;
+        late_wait_d = 0;
       end
     end
     DATA: begin
       if(baud_acc_overflow) begin
-        // When the baud interval has elapsed
+        // The baud interval elapses in the middle of the bit
+        vote_d[1] = uart_rx_qqq;
+        late_wait_d = cr_ovs_i;
+      end else if(!vote_taken_q && (baud_acc_q[23:20] == 4'b1111)) begin
+        // Take the early sample of the bit at 15/16 of the baud interval
+        vote_d[0] = uart_rx_qqq;
+        vote_taken_d = 1;
+      end
+
+      // The bit is committed in its middle, or at 1/16 of the next baud
+      // interval when oversampling so that the samples are centered
+      if(cr_ovs_i ? (late_wait_q && (baud_acc_q[23:20] != '0)) : baud_acc_overflow) begin
         //   1. decrement the frame bit counter
         //   1. sample the input
         //   1. update the computed parity
         frame_bit_cnt_d = {frame_bit_cnt_d[MAX_FRAME_SIZE-1:0], 1'b0};
-        frame_d = {uart_rx_qqq, frame_q[10:1]};
-        parity_d = parity_q ^ (uart_rx_qqq & (~data_bit_cnt_done_q));
+        frame_d = {sample, frame_q[10:1]};
+        parity_d = parity_q ^ (sample & (~data_bit_cnt_done_q));
+        noise_d = noise_q | (cr_ovs_i & sample_noise);
+        vote_taken_d = 0;
+        late_wait_d = 0;
       end
-      baud_acc_d = {1'b0, baud_acc_q[15:0]} + cr_acc_incr_i;
+      baud_acc_d = {1'b0, baud_acc_q[23:0]} + {1'b0, acc_incr};
 
       // Reset the counter as it will not be incremented further
       if(frame_bit_cnt_done) begin
@@ -169,6 +247,79 @@ always_comb begin : sampling
   endcase
 end
 
+always_comb begin : majority_vote
+  // The early sample is skipped when the baud interval is too short for it,
+  // the middle sample being used instead
+  vote0 = vote_taken_q ? vote_q[0] : vote_q[1];
+  vote1 = vote_q[1];
+
+  // The bit value is the majority of the early, middle and late samples
+  // when oversampling is enabled, otherwise only the middle sample is used
+  sample = cr_ovs_i ? ((vote0 & vote1) | (vote0 & uart_rx_qqq) | (vote1 & uart_rx_qqq))
+                    : uart_rx_qqq;
+  // Noise is detected when the samples disagree
+  sample_noise = (vote0 != uart_rx_qqq) || (vote1 != uart_rx_qqq);
+end
+
+always_comb begin : break_detection
+  // A break is detected when all the bits of the frame, including the
+  // stop bits, are received low. The line must then go back high before
+  // the next start bit so that a single break is reported.
+  break_detected = frame_bit_cnt_done && (frame_shifted == '0);
+
+  break_wait_d = break_wait_q;
+  if(break_detected) begin
+    break_wait_d = 1;
+  end else if(uart_rx_qq == 1) begin
+    break_wait_d = 0;
+  end
+end
+
+always_comb begin : address_filter
+  // The address mark is received in place of the parity bit
+  frame_data = cr_ds_i ? frame_shifted[7:0] : {1'b0, frame_shifted[6:0]};
+  addr_frame = cr_mpe_i && parity_bit;
+  addr_match = addr_frame && (((frame_data ^ mpe_addr_i) & mpe_mask_i) == '0);
+
+  // Each address frame selects or deselects the node for the next frames
+  selected_d = selected_q;
+  if(!cr_mpe_i) begin
+    selected_d = 0;
+  end else if(frame_bit_cnt_done && addr_frame) begin
+    selected_d = addr_match;
+  end
+
+  // Address frames are never output. A break is always output as it
+  // concerns all the nodes.
+  frame_accepted = !cr_mpe_i || (!addr_frame && selected_q) || break_detected;
+end
+
+always_comb begin : idle_timeout
+  idle_cnt_d = idle_cnt_q;
+  timeout_armed_d = timeout_armed_q;
+  timeout = 0;
+
+  if((state_q == DATA) && frame_bit_cnt_done && (frame_accepted || addr_match)) begin
+    // The idle time is measured from the end of each frame when enabled.
+    // Frames addressed to other nodes are ignored.
+    timeout_armed_d = (rtor_rto_i != '0);
+    idle_cnt_d = '0;
+  end else if(timeout_armed_q) begin
+    if((state_q == START) && baud_acc_half_overflow && !false_start) begin
+      // A new frame is starting. The timeout stays armed until the start bit
+      // is confirmed so that a glitch on the idle line does not cancel it.
+      timeout_armed_d = 0;
+    end else if((state_q == IDLE) && baud_acc_overflow) begin
+      idle_cnt_d = idle_cnt_q + 1;
+      // The timeout is only reported once per burst of frames
+      if(idle_cnt_d == rtor_rto_i) begin
+        timeout = 1;
+        timeout_armed_d = 0;
+      end
+    end
+  end
+end
+
 always_comb begin : frame_align
   // Barrel shifter to align the frame_q shift register output
   frame_shifted0 = frame_start_index[0] ? {1'b0, frame_q[MAX_FRAME_SIZE-1:1]} : frame_q;
@@ -188,6 +339,14 @@ always_ff @(posedge clk_i) begin
     frame_bit_cnt_q     <= '0;
     data_bit_cnt_done_q <=  0;
     parity_q            <=  0;
+    noise_q             <=  0;
+    vote_q              <= '0;
+    vote_taken_q        <=  0;
+    late_wait_q         <=  0;
+    idle_cnt_q          <= '0;
+    timeout_armed_q     <=  0;
+    break_wait_q        <=  0;
+    selected_q          <=  0;
   end else begin
     state_q <= state_d;
 
@@ -211,6 +370,22 @@ always_ff @(posedge clk_i) begin
 
     // Computed parity
     parity_q <= parity_d;
+
+    // Majority vote
+    noise_q <= noise_d;
+    vote_q <= vote_d;
+    vote_taken_q <= vote_taken_d;
+    late_wait_q <= late_wait_d;
+
+    // Idle line detection
+    idle_cnt_q <= idle_cnt_d;
+    timeout_armed_q <= timeout_armed_d;
+
+    // Break detection
+    break_wait_q <= break_wait_d;
+
+    // Address filtering
+    selected_q <= selected_d;
   end
 end
 
@@ -222,8 +397,16 @@ assign frame_o = frame_shifted;
 // A parity error is detected when
 //  - The computed parity is different than the received parity bit
 //  - Parity detection is enabled
-assign parity_err_o = (parity_q ^ parity_bit) & (cr_p_i[0] | cr_p_i[1]);
+//  - The parity bit is not replaced by the address mark
+assign parity_err_o = (parity_q ^ parity_bit) & (cr_p_i[0] | cr_p_i[1]) & ~cr_mpe_i;
 assign frame_err_o = (frame_q[MAX_FRAME_SIZE-1] == 0);
-assign output_valid_o = frame_bit_cnt_done;
+assign noise_err_o = noise_q;
+assign break_o = break_detected;
+assign output_valid_o = frame_bit_cnt_done && frame_accepted;
+assign addr_match_o = frame_bit_cnt_done && addr_match;
+assign false_start_o = false_start;
+assign timeout_o = timeout;
+// No frame is being received
+assign idle_o = (state_q == IDLE);
 
 endmodule // rx_frontend
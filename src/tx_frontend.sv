@@ -28,16 +28,37 @@ module tx_frontend #(
   input   logic         rst_i,
 
   input   logic[15:0]   cr_acc_incr_i,
+  input   logic[7:0]    cr_acc_frac_i,
   input   logic         cr_ds_i,
   input   logic[1:0]    cr_p_i,
   input   logic         cr_s_i,
+  // In multiprocessor mode, the parity bit is replaced by mark_i
+  input   logic         cr_mpe_i,
 
   input   logic         transmit_i,
   input   logic[7:0]    dr_i,
+  input   logic         mark_i,
+  output  logic         ready_o,
+
+  // A break of break_len_i + 1 bit times is sent instead of the next frame
+  // while break_i is asserted
+  input   logic         break_i,
+  input   logic[7:0]    break_len_i,
+  output  logic         break_done_o,
+
+  // The driver enable is asserted de_lead_i bit times before the start bit
+  // and deasserted de_trail_i bit times after the last stop bit
+  input   logic[7:0]    de_lead_i,
+  input   logic[7:0]    de_trail_i,
 
   output  logic         done_o,
+  // Asserted during the first cycle of each start bit on uart_tx_o
+  output  logic         start_o,
+  // Asserted while no frame, break or guard time is being sent
+  output  logic         idle_o,
 
-  output  logic         uart_tx_o
+  output  logic         uart_tx_o,
+  output  logic         uart_de_o
 );
 
 /*****************************************/
@@ -49,12 +70,15 @@ typedef enum {
   START,    // 1
   DATA,     // 2
   PARITY,   // 3
-  STOP      // 4
+  STOP,     // 4
+  BREAK,    // 5
+  LEAD,     // 6
+  TRAIL     // 7
 } state_t;
 state_t state_d, state_q;
 
-// Baudrate accumulator
-logic[16:0] baud_acc_d, baud_acc_q;
+// Baudrate accumulator, extended with the fractional part of the increment
+logic[24:0] baud_acc_d, baud_acc_q;
 logic baud_acc_overflow;
 
 // Frame bit counter
@@ -65,29 +89,65 @@ logic[$size(dr_i)-1:0] dr_d, dr_q;
 
 logic parity_d, parity_q;
 
+// Number of remaining bit times of the break
+logic[7:0] break_cnt_d, break_cnt_q;
+
+// Number of remaining bit times of the driver enable guard time
+logic[7:0] de_cnt_d, de_cnt_q;
+// Asserted when the guard time before the start bit precedes a break
+logic lead_break_d, lead_break_q;
+logic lead_done, trail_done;
+
+// Asserted when the next data can be loaded
+logic ready;
+logic launch;
+logic last_stop_bit;
+// Asserted when a break is started instead of the next frame
+logic break_start;
+logic break_done;
+
 /*****************************************/
 /*            Output signals             */
 /*****************************************/
 
 logic uart_tx_d, uart_tx_q;
+logic uart_de_d, uart_de_q;
 
 logic done_d, done_q;
+logic start_d, start_q;
 
 /*****************************************/
 
 always_comb begin : baudrate_generation
   // Reset the baud accumulator when in the IDLE state
-  if(state_q == IDLE && transmit_i) begin
+  if(state_q == IDLE && (transmit_i || break_i)) begin
     baud_acc_d = 0;
   end else begin
     // Increment the accumulator
-    // In this case, baud_acc_q[15] is not used as we want this bit
+    // In this case, baud_acc_q[24] is not used as we want this bit
     // to be set to one only when the increment overflows.
     // In that case, on the next cycle this bit is not used but the 
     // remaining bits are.
-    baud_acc_d = {1'b0, baud_acc_q[15:0]} + {1'b0, cr_acc_incr_i};
+    baud_acc_d = {1'b0, baud_acc_q[23:0]} + {1'b0, cr_acc_incr_i, cr_acc_frac_i};
   end
-  baud_acc_overflow = baud_acc_d[16];
+  baud_acc_overflow = baud_acc_d[24];
+end
+
+always_comb begin : data_loading
+  // The last stop bit ends at the end of the baud interval
+  last_stop_bit = (state_q == STOP) && baud_acc_overflow && bit_cnt_q[0];
+  // The next data is loaded either when idle or at the end of the
+  // previous frame so that frames can be sent back-to-back. During the
+  // guard time after a frame, it is loaded at the end of a bit time.
+  // A requested break is sent before the next data.
+  launch = (state_q == IDLE) || last_stop_bit || ((state_q == TRAIL) && baud_acc_overflow);
+  ready = launch && !break_i;
+  break_start = launch && break_i;
+  // The break ends at the end of its last bit time
+  break_done = (state_q == BREAK) && baud_acc_overflow && (break_cnt_q == '0);
+  // The guard times end at the end of their last bit time
+  lead_done = (state_q == LEAD) && baud_acc_overflow && (de_cnt_q == '0);
+  trail_done = (state_q == TRAIL) && baud_acc_overflow && (de_cnt_q == '0);
 end
 
 always_comb begin : state_machine
@@ -95,11 +155,22 @@ always_comb begin : state_machine
 
   case(state_q)
     IDLE: begin
-      // If a transmit is initiated
-      if(transmit_i) begin
+      // If a transmit is initiated, the driver enable guard time is
+      // inserted first
+      if((break_i || transmit_i) && (de_lead_i != '0)) begin
+        state_d = LEAD;
+      end else if(break_i) begin
+        state_d = BREAK;
+      end else if(transmit_i) begin
         state_d = START;
       end 
     end
+    LEAD: begin
+      // The loaded data or break is sent after the guard time
+      if(lead_done) begin
+        state_d = lead_break_q ? BREAK : START;
+      end
+    end
     START: begin
       // Wait for a baud interval (1-bit)
       if(baud_acc_overflow) begin
@@ -110,7 +181,7 @@ always_comb begin : state_machine
       // Wait for the end of the last baud interval (all data-bits)
       if(baud_acc_overflow && bit_cnt_q[0]) begin
         // Bypass the parity bit based on configuration
-        if(cr_p_i == '0) begin
+        if((cr_p_i == '0) && !cr_mpe_i) begin
           state_d = STOP;
         end else begin
           state_d = PARITY;
@@ -125,8 +196,37 @@ always_comb begin : state_machine
     end
     STOP: begin
       // Wait for the last baud interval (n stop bits)
-      if(baud_acc_overflow && bit_cnt_q[0]) begin
-        state_d = IDLE;
+      if(last_stop_bit) begin
+        // Chain the next frame directly without going through IDLE.
+        // The baud accumulator is not reset to preserve the baud phase.
+        if(break_i) begin
+          state_d = BREAK;
+        end else if(transmit_i) begin
+          state_d = START;
+        end else if(de_trail_i != '0) begin
+          state_d = TRAIL;
+        end else begin
+          state_d = IDLE;
+        end
+      end
+    end
+    TRAIL: begin
+      // The line is still driven so that a frame can follow without
+      // a new guard time
+      if(baud_acc_overflow) begin
+        if(break_i) begin
+          state_d = BREAK;
+        end else if(transmit_i) begin
+          state_d = START;
+        end else if(trail_done) begin
+          state_d = IDLE;
+        end
+      end
+    end
+    BREAK: begin
+      // The break is followed by the stop bits
+      if(break_done) begin
+        state_d = STOP;
       end
     end
     default: begin end
@@ -140,19 +240,11 @@ always_comb begin : transmit
 
   bit_cnt_d = bit_cnt_q;
   parity_d = parity_q;
+  break_cnt_d = break_cnt_q;
+  de_cnt_d = de_cnt_q;
+  lead_break_d = lead_break_q;
 
   case(state_q)
-    IDLE: begin
-      // If a transmit is initiated
-      if(transmit_i) begin
-        // Initialize the number of bits to send
-        bit_cnt_d = cr_ds_i ? (1 << 7) : (1 << 6);
-        // Initialize the data shift register
-        dr_d = dr_i;
-        // Initialize the parity
-        parity_d = cr_p_i[0];
-      end
-    end
     START: begin
       uart_tx_d = 1'b0;
     end 
@@ -166,8 +258,10 @@ always_comb begin : transmit
         // Shift the data register
         dr_d = {1'b0, dr_q[$size(dr_i)-1:1]};
 
-        // Update the parity with the sent bit
-        parity_d = parity_q ^ dr_q[0];
+        // Update the parity with the sent bit, unless it holds the address mark
+        if(!cr_mpe_i) begin
+          parity_d = parity_q ^ dr_q[0];
+        end
 
         // Set the number of stop bits for the stop state
         if(bit_cnt_q[0]) begin
@@ -187,8 +281,50 @@ always_comb begin : transmit
         bit_cnt_d = {1'b0, bit_cnt_q[$size(dr_i)-1:1]};
       end
     end
+    BREAK: begin
+      uart_tx_d = 1'b0;
+
+      if(baud_acc_overflow) begin
+        break_cnt_d = break_cnt_q - 1;
+      end
+      // Set the number of stop bits for the stop state
+      if(break_done) begin
+        bit_cnt_d = cr_s_i ? (1 << 1) : (1 << 0);
+      end
+    end
+    LEAD, TRAIL: begin
+      if(baud_acc_overflow) begin
+        de_cnt_d = de_cnt_q - 1;
+      end
+    end
     default: begin end
   endcase
+
+  if(break_start) begin
+    break_cnt_d = break_len_i;
+  end
+
+  // Initialize the guard times
+  if((state_q == IDLE) && (state_d == LEAD)) begin
+    de_cnt_d = de_lead_i - 1;
+    lead_break_d = break_i;
+  end
+  if(last_stop_bit && (state_d == TRAIL)) begin
+    de_cnt_d = de_trail_i - 1;
+  end
+
+  // The driver enable is aligned with the transmitted bits
+  uart_de_d = (state_q != IDLE);
+
+  // If a transmit is initiated
+  if(ready && transmit_i) begin
+    // Initialize the number of bits to send
+    bit_cnt_d = cr_ds_i ? (1 << 7) : (1 << 6);
+    // Initialize the data shift register
+    dr_d = dr_i;
+    // Initialize the parity, or the address mark in multiprocessor mode
+    parity_d = cr_mpe_i ? mark_i : cr_p_i[0];
+  end
 end
 
 always_comb begin : done
@@ -197,9 +333,13 @@ always_comb begin : done
   //   - in the stop STATE
   //   - at the end of a baud interval
   //   - during the last stop bit
-  if(state_q == STOP && baud_acc_overflow && bit_cnt_q[0]) begin
+  if(last_stop_bit) begin
     done_d = 1;
   end
+
+  // The start bit is output on the cycle following the first cycle of the
+  // START state, the line being high before it in every other state
+  start_d = (state_q == START) && uart_tx_q;
 end
 
 always_ff @(posedge clk_i) begin
@@ -210,10 +350,15 @@ always_ff @(posedge clk_i) begin
     baud_acc_q <= 0;
     bit_cnt_q <= 0;
     parity_q <= 0;
+    break_cnt_q <= '0;
+    de_cnt_q <= '0;
+    lead_break_q <= 0;
 
     done_q <= 0;
+    start_q <= 0;
 
     uart_tx_q <= 1;
+    uart_de_q <= 0;
   end else begin
     state_q <= state_d;
 
@@ -226,13 +371,22 @@ always_ff @(posedge clk_i) begin
     // Computed parity
     parity_q <= parity_d;
 
+    // Remaining bit times of the break
+    break_cnt_q <= break_cnt_d;
+
+    // Remaining bit times of the driver enable guard time
+    de_cnt_q <= de_cnt_d;
+    lead_break_q <= lead_break_d;
+
     // The bit counter used to detect the end of multi-bit transmit states
     bit_cnt_q <= bit_cnt_d;
 
     // Asserted to indicate the end of a transmission
     done_q <= done_d;
+    start_q <= start_d;
 
     uart_tx_q <= uart_tx_d;
+    uart_de_q <= uart_de_d;
   end
 end
 
@@ -241,6 +395,11 @@ end
 /*****************************************/
 
 assign uart_tx_o = uart_tx_q;
+assign uart_de_o = uart_de_q;
+assign ready_o = ready;
+assign break_done_o = break_done;
 assign done_o = done_q;
+assign start_o = start_q;
+assign idle_o = (state_q == IDLE);
 
 endmodule // tx_frontend
@@ -0,0 +1,278 @@
+/*           __        _
+ *  ________/ /  ___ _(_)__  ___
+ * / __/ __/ _ \/ _ `/ / _ \/ -_)
+ * \__/\__/_//_/\_,_/_/_//_/\__/
+ * 
+ * Copyright (C) Clément Chaine
+ * This file is part of ECAP5-DWBUART <https://github.com/ecap5/ECAP5-DWBUART>
+ *
+ * ECAP5-DWBUART is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ECAP5-DWBUART is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ECAP5-DWBUART.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <verilated.h>
+#include <verilated_vcd_c.h>
+#include <svdpi.h>
+
+#include "Vtb_autobaud.h"
+#include "Vtb_autobaud_autobaud.h"
+#include "Vtb_autobaud_tb_autobaud.h"
+#include "testbench.h"
+
+enum CondId {
+  COND_state,
+  COND_width,
+  COND_done,
+  __CondIdEnd
+};
+
+enum TestcaseId {
+  T_IDLE     = 1,
+  T_MEASURE  = 2,
+  T_ROUNDING = 3
+};
+
+enum StateId {
+  S_IDLE = 0,
+  S_START,
+  S_MEASURE,
+  S_WAIT
+};
+
+class TB_Autobaud : public Testbench<Vtb_autobaud> {
+public:
+  void reset() {
+    this->_nop();
+
+    this->core->rst_i = 1;
+    for(int i = 0; i < 5; i++) {
+      this->tick();
+    }
+    this->core->rst_i = 0;
+
+    Testbench<Vtb_autobaud>::reset();
+  }
+  
+  void _nop() {
+    core->enable_i = 0;
+    core->frame_bits_i = 0;
+    core->uart_rx_i = 1;
+  }
+
+  /**
+   * Sends the 0x55 synchronization character in 8N1 with the given
+   * number of clock cycles per bit.
+   * Returns the cycle, counted from the start bit, at which done_o is asserted.
+   */
+  uint32_t send_sync(uint32_t cycles_per_bit) {
+    // start bit, 8 data bits, stop bit
+    uint32_t bits = (1 << 9) | (0x55 << 1);
+
+    uint32_t done_cycle = 0;
+    for(uint32_t i = 0; i < 11; i++) {
+      // The line is idle after the stop bit
+      this->core->uart_rx_i = (i < 10) ? ((bits >> i) & 1) : 1;
+      for(uint32_t j = 0; j < cycles_per_bit; j++) {
+        this->tick();
+
+        if(this->core->done_o) {
+          // Only a single done pulse is expected
+          this->check(COND_done, (done_cycle == 0));
+          done_cycle = i * cycles_per_bit + j;
+        }
+      }
+    }
+    return done_cycle;
+  }
+};
+
+void tb_autobaud_idle(TB_Autobaud * tb) {
+  Vtb_autobaud * core = tb->core;
+  core->testcase = T_IDLE;
+
+  //=================================
+  //      Tick (0)
+  
+  tb->reset();
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  tb->check(COND_state, (core->tb_autobaud->dut->state_q == S_IDLE));
+  tb->check(COND_done,  (core->done_o == 0));
+
+  //=================================
+  //      Tick (1-...)
+  
+  // The measure is not performed when disabled
+  uint32_t done_cycle = tb->send_sync(16);
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  tb->check(COND_state, (core->tb_autobaud->dut->state_q == S_IDLE));
+  tb->check(COND_width, (core->width_o == 0));
+  tb->check(COND_done,  (done_cycle == 0));
+
+  //`````````````````````````````````
+  //      Formal Checks 
+  
+  CHECK("tb_autobaud.idle.01",
+      tb->conditions[COND_state],
+      "Failed to implement the state machine", tb->err_cycles[COND_state]);
+
+  CHECK("tb_autobaud.idle.02",
+      tb->conditions[COND_width],
+      "Failed to implement the width measure", tb->err_cycles[COND_width]);
+
+  CHECK("tb_autobaud.idle.03",
+      tb->conditions[COND_done],
+      "Failed to implement the done signal", tb->err_cycles[COND_done]);
+}
+
+void tb_autobaud_measure(TB_Autobaud * tb) {
+  Vtb_autobaud * core = tb->core;
+  core->testcase = T_MEASURE;
+
+  //=================================
+  //      Tick (0)
+  
+  tb->reset();
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  core->enable_i = 1;
+  core->frame_bits_i = 8;
+
+  //=================================
+  //      Tick (1-2)
+  
+  tb->n_tick(2);
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  tb->check(COND_state, (core->tb_autobaud->dut->state_q == S_START));
+
+  //=================================
+  //      Tick (3-...)
+  
+  uint32_t done_cycle = tb->send_sync(16);
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  // (2**24)/16 = 4096 << 8
+  tb->check(COND_width, (core->width_o == 16) &&
+                        (core->acc_incr_o == (4096 << 8)));
+  // The measure is done in the middle of the stop bit, delayed by the
+  // input registering
+  tb->check(COND_done,  (done_cycle == (9 * 16 + 8 + 2)));
+
+  //`````````````````````````````````
+  //      Formal Checks 
+  
+  CHECK("tb_autobaud.measure.01",
+      tb->conditions[COND_state],
+      "Failed to implement the state machine", tb->err_cycles[COND_state]);
+
+  CHECK("tb_autobaud.measure.02",
+      tb->conditions[COND_width],
+      "Failed to implement the width measure", tb->err_cycles[COND_width]);
+
+  CHECK("tb_autobaud.measure.03",
+      tb->conditions[COND_done],
+      "Failed to implement the done signal", tb->err_cycles[COND_done]);
+}
+
+void tb_autobaud_rounding(TB_Autobaud * tb) {
+  Vtb_autobaud * core = tb->core;
+  core->testcase = T_ROUNDING;
+
+  uint32_t widths[] = {4, 10, 208, 2500};
+  size_t num_widths = sizeof(widths)/sizeof(uint32_t);
+
+  for(size_t i = 0; i < num_widths; i++) {
+    //=================================
+    //      Tick (0)
+    
+    tb->reset();
+
+    //`````````````````````````````````
+    //      Set inputs
+    
+    core->enable_i = 1;
+    core->frame_bits_i = 8;
+
+    //=================================
+    //      Tick (1-...)
+    
+    tb->n_tick(2);
+    uint32_t done_cycle = tb->send_sync(widths[i]);
+
+    //`````````````````````````````````
+    //      Checks 
+    
+    uint32_t expected = ((1 << 25) / widths[i] + 1) / 2;
+    tb->check(COND_width, (core->width_o == widths[i]) &&
+                          (core->acc_incr_o == expected));
+    tb->check(COND_done,  (done_cycle > 0));
+  }
+
+  //`````````````````````````````````
+  //      Formal Checks 
+  
+  CHECK("tb_autobaud.rounding.01",
+      tb->conditions[COND_width],
+      "Failed to implement the width measure", tb->err_cycles[COND_width]);
+
+  CHECK("tb_autobaud.rounding.02",
+      tb->conditions[COND_done],
+      "Failed to implement the done signal", tb->err_cycles[COND_done]);
+}
+
+int main(int argc, char ** argv, char ** env) {
+  srand(time(NULL));
+  Verilated::traceEverOn(true);
+
+  bool verbose = parse_verbose(argc, argv);
+
+  TB_Autobaud * tb = new TB_Autobaud;
+  tb->open_trace("waves/autobaud.vcd");
+  tb->open_testdata("testdata/autobaud.csv");
+  tb->set_debug_log(verbose);
+  tb->init_conditions(__CondIdEnd);
+
+  /************************************************************/
+
+  tb_autobaud_idle(tb);
+
+  tb_autobaud_measure(tb);
+  tb_autobaud_rounding(tb);
+
+  /************************************************************/
+
+  printf("[AUTOBAUD]: ");
+  if(tb->success) {
+    printf("Done\n");
+  } else {
+    printf("Failed\n");
+  }
+
+  delete tb;
+  exit(EXIT_SUCCESS);
+}
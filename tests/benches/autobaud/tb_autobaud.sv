@@ -0,0 +1,60 @@
+/*           __        _
+ *  ________/ /  ___ _(_)__  ___
+ * / __/ __/ _ \/ _ `/ / _ \/ -_)
+ * \__/\__/_//_/\_,_/_/_//_/\__/
+ * 
+ * Copyright (C) Clément Chaine
+ * This file is part of ECAP5-DWBUART <https://github.com/ecap5/ECAP5-DWBUART>
+ *
+ * ECAP5-DWBUART is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ECAP5-DWBUART is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ECAP5-DWBUART.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+module tb_autobaud
+(
+  input   int          testcase,
+
+  input   logic         clk_i,
+  input   logic         rst_i,
+
+  input   logic         enable_i,
+  input   logic[3:0]    frame_bits_i,
+
+  input   logic         uart_rx_i,
+
+  output  logic[19:0]   width_o,
+  output  logic[23:0]   acc_incr_o,
+  output  logic         done_o
+);
+
+autobaud #(
+  .WIDTH_SIZE (20)
+) dut (
+  .clk_i        (clk_i),
+  .rst_i        (rst_i),
+
+  .enable_i     (enable_i),
+  .frame_bits_i (frame_bits_i),
+
+  .uart_rx_i    (uart_rx_i),
+
+  .width_o      (width_o),
+  .acc_incr_o   (acc_incr_o),
+  .done_o       (done_o)
+);
+
+endmodule // tb_autobaud
+
+`verilator_config
+
+public -module "autobaud" -var "state_q"
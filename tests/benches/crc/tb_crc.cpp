@@ -0,0 +1,308 @@
+/*           __        _
+ *  ________/ /  ___ _(_)__  ___
+ * / __/ __/ _ \/ _ `/ / _ \/ -_)
+ * \__/\__/_//_/\_,_/_/_//_/\__/
+ * 
+ * Copyright (C) Clément Chaine
+ * This file is part of ECAP5-DWBUART <https://github.com/ecap5/ECAP5-DWBUART>
+ *
+ * ECAP5-DWBUART is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ECAP5-DWBUART is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ECAP5-DWBUART.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <verilated.h>
+#include <verilated_vcd_c.h>
+#include <svdpi.h>
+
+#include "Vtb_crc.h"
+#include "Vtb_crc_crc.h"
+#include "Vtb_crc_tb_crc.h"
+#include "testbench.h"
+
+enum CondId {
+  COND_crc,
+  __CondIdEnd
+};
+
+enum TestcaseId {
+  T_IDLE   = 1,
+  T_CRC32  = 2,
+  T_CRC16  = 3,
+  T_CLEAR  = 4
+};
+
+// Check string of the CRC catalogue
+const char * CHECK_STRING = "123456789";
+
+class TB_Crc : public Testbench<Vtb_crc> {
+public:
+  void reset() {
+    this->_nop();
+
+    this->core->rst_i = 1;
+    for(int i = 0; i < 5; i++) {
+      this->tick();
+    }
+    this->core->rst_i = 0;
+
+    Testbench<Vtb_crc>::reset();
+  }
+  
+  void _nop() {
+    core->clear_i = 0;
+    core->valid_i = 0;
+    core->data_i = 0;
+  }
+
+  void configure(uint8_t w32, uint8_t ref, uint32_t poly, uint32_t init) {
+    core->cr_w32_i = w32;
+    core->cr_ref_i = ref;
+    core->poly_i = poly;
+    core->init_i = init;
+
+    core->clear_i = 1;
+    this->tick();
+    this->_nop();
+  }
+
+  void accumulate(const char * data) {
+    for(int i = 0; data[i] != '\0'; i++) {
+      core->valid_i = 1;
+      core->data_i = data[i];
+      this->tick();
+    }
+    this->_nop();
+  }
+};
+
+void tb_crc_idle(TB_Crc * tb) {
+  Vtb_crc * core = tb->core;
+  core->testcase = T_IDLE;
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  core->cr_w32_i = 1;
+  core->cr_ref_i = 0;
+  core->init_i = 0xA5A5A5A5;
+
+  //=================================
+  //      Tick (0)
+  
+  tb->reset();
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  // The CRC is reset to its initial value
+  tb->check(COND_crc, (core->crc_o == 0xA5A5A5A5));
+
+  //=================================
+  //      Tick (1)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  // The CRC is held while no byte is accumulated
+  tb->check(COND_crc, (core->crc_o == 0xA5A5A5A5));
+
+  //`````````````````````````````````
+  //      Formal Checks 
+  
+  CHECK("tb_crc.idle.01",
+      tb->conditions[COND_crc],
+      "Failed to implement the CRC output", tb->err_cycles[COND_crc]);
+}
+
+void tb_crc_crc32(TB_Crc * tb) {
+  Vtb_crc * core = tb->core;
+  core->testcase = T_CRC32;
+
+  //=================================
+  //      Tick (0)
+  
+  tb->reset();
+
+  //=================================
+  //      Tick (1)
+  
+  // CRC-32 : reflected, init FFFF_FFFFh
+  tb->configure(1, 1, 0x04C11DB7, 0xFFFFFFFF);
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  tb->check(COND_crc, (core->crc_o == 0xFFFFFFFF));
+
+  //=================================
+  //      Tick (2-10)
+  
+  tb->accumulate(CHECK_STRING);
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  // The catalogue value CBF43926h is the complement of the CRC register
+  tb->check(COND_crc, (core->crc_o == (uint32_t)~0xCBF43926));
+
+  //=================================
+  //      Tick (11)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  tb->check(COND_crc, (core->crc_o == (uint32_t)~0xCBF43926));
+
+  //`````````````````````````````````
+  //      Formal Checks 
+  
+  CHECK("tb_crc.crc32.01",
+      tb->conditions[COND_crc],
+      "Failed to implement the 32-bit CRC", tb->err_cycles[COND_crc]);
+}
+
+void tb_crc_crc16(TB_Crc * tb) {
+  Vtb_crc * core = tb->core;
+  core->testcase = T_CRC16;
+
+  // CRC-16/CCITT-FALSE and CRC-16/MODBUS
+  uint8_t  ref[]      = {0, 1};
+  uint32_t poly[]     = {0x1021, 0x8005};
+  uint32_t expected[] = {0x29B1, 0x4B37};
+
+  for(int i = 0; i < 2; i++) {
+    //=================================
+    //      Tick (0)
+    
+    tb->reset();
+
+    //=================================
+    //      Tick (1)
+    
+    // The upper half of the polynomial and init value are ignored
+    tb->configure(0, ref[i], 0xFFFF0000 | poly[i], 0xFFFFFFFF);
+
+    //`````````````````````````````````
+    //      Checks 
+    
+    tb->check(COND_crc, (core->crc_o == 0xFFFF));
+
+    //=================================
+    //      Tick (2-10)
+    
+    tb->accumulate(CHECK_STRING);
+
+    //`````````````````````````````````
+    //      Checks 
+    
+    tb->check(COND_crc, (core->crc_o == expected[i]));
+  }
+
+  //`````````````````````````````````
+  //      Formal Checks 
+  
+  CHECK("tb_crc.crc16.01",
+      tb->conditions[COND_crc],
+      "Failed to implement the 16-bit CRC", tb->err_cycles[COND_crc]);
+}
+
+void tb_crc_clear(TB_Crc * tb) {
+  Vtb_crc * core = tb->core;
+  core->testcase = T_CLEAR;
+
+  //=================================
+  //      Tick (0)
+  
+  tb->reset();
+
+  //=================================
+  //      Tick (1-10)
+  
+  tb->configure(1, 1, 0x04C11DB7, 0xFFFFFFFF);
+  tb->accumulate("garbage");
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  // The first byte is accumulated on the cleared CRC
+  core->clear_i = 1;
+  core->valid_i = 1;
+  core->data_i = CHECK_STRING[0];
+
+  //=================================
+  //      Tick (11)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  tb->_nop();
+
+  //=================================
+  //      Tick (12-19)
+  
+  tb->accumulate(CHECK_STRING + 1);
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  tb->check(COND_crc, (core->crc_o == (uint32_t)~0xCBF43926));
+
+  //`````````````````````````````````
+  //      Formal Checks 
+  
+  CHECK("tb_crc.clear.01",
+      tb->conditions[COND_crc],
+      "Failed to implement the clear signal", tb->err_cycles[COND_crc]);
+}
+
+int main(int argc, char ** argv, char ** env) {
+  srand(time(NULL));
+  Verilated::traceEverOn(true);
+
+  bool verbose = parse_verbose(argc, argv);
+
+  TB_Crc * tb = new TB_Crc;
+  tb->open_trace("waves/crc.vcd");
+  tb->open_testdata("testdata/crc.csv");
+  tb->set_debug_log(verbose);
+  tb->init_conditions(__CondIdEnd);
+
+  /************************************************************/
+
+  tb_crc_idle(tb);
+
+  tb_crc_crc32(tb);
+  tb_crc_crc16(tb);
+  tb_crc_clear(tb);
+
+  /************************************************************/
+
+  printf("[CRC]: ");
+  if(tb->success) {
+    printf("Done\n");
+  } else {
+    printf("Failed\n");
+  }
+
+  delete tb;
+  exit(EXIT_SUCCESS);
+}
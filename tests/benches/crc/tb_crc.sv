@@ -0,0 +1,64 @@
+/*           __        _
+ *  ________/ /  ___ _(_)__  ___
+ * / __/ __/ _ \/ _ `/ / _ \/ -_)
+ * \__/\__/_//_/\_,_/_/_//_/\__/
+ * 
+ * Copyright (C) Clément Chaine
+ * This file is part of ECAP5-DWBUART <https://github.com/ecap5/ECAP5-DWBUART>
+ *
+ * ECAP5-DWBUART is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ECAP5-DWBUART is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ECAP5-DWBUART.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+module tb_crc
+(
+  input   int          testcase,
+
+  input   logic         clk_i,
+  input   logic         rst_i,
+
+  input   logic         cr_w32_i,
+  input   logic         cr_ref_i,
+  input   logic[31:0]   poly_i,
+  input   logic[31:0]   init_i,
+
+  input   logic         clear_i,
+
+  input   logic         valid_i,
+  input   logic[7:0]    data_i,
+
+  output  logic[31:0]   crc_o
+);
+
+crc dut (
+  .clk_i     (clk_i),
+  .rst_i     (rst_i),
+
+  .cr_w32_i  (cr_w32_i),
+  .cr_ref_i  (cr_ref_i),
+  .poly_i    (poly_i),
+  .init_i    (init_i),
+
+  .clear_i   (clear_i),
+
+  .valid_i   (valid_i),
+  .data_i    (data_i),
+
+  .crc_o     (crc_o)
+);
+
+endmodule // tb_crc
+
+`verilator_config
+
+public -module "crc" -var "crc_q"
@@ -0,0 +1,545 @@
+/*           __        _
+ *  ________/ /  ___ _(_)__  ___
+ * / __/ __/ _ \/ _ `/ / _ \/ -_)
+ * \__/\__/_//_/\_,_/_/_//_/\__/
+ * 
+ * Copyright (C) Clément Chaine
+ * This file is part of ECAP5-DWBUART <https://github.com/ecap5/ECAP5-DWBUART>
+ *
+ * ECAP5-DWBUART is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ECAP5-DWBUART is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ECAP5-DWBUART.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <deque>
+#include <vector>
+#include <verilated.h>
+#include <verilated_vcd_c.h>
+#include <svdpi.h>
+
+#include "Vtb_dma_master.h"
+#include "Vtb_dma_master_dma_master.h"
+#include "Vtb_dma_master_tb_dma_master.h"
+#include "testbench.h"
+
+// Base address and size of the memory model
+#define MEM_BASE 0x1000
+#define MEM_SIZE 256
+
+enum CondId {
+  COND_state,
+  COND_bus,
+  COND_fifo,
+  COND_done,
+  __CondIdEnd
+};
+
+enum TestcaseId {
+  T_IDLE = 1,
+  T_TX   = 2,
+  T_RX   = 3,
+  T_PRIORITY = 4
+};
+
+enum StateId {
+  S_IDLE = 0,
+  S_TX_REQ,
+  S_TX_WAIT,
+  S_RX_REQ,
+  S_RX_WAIT
+};
+
+struct Access {
+  uint32_t adr;
+  uint32_t dat;
+  bool     we;
+  uint8_t  sel;
+};
+
+class TB_Dma_master : public Testbench<Vtb_dma_master> {
+public:
+  uint8_t mem[MEM_SIZE];
+
+  // Accesses acknowledged by the memory model
+  std::vector<Access> accesses;
+  // Entries pushed to the transmit fifo
+  std::vector<uint64_t> tx_pushes;
+  // Content of the receive fifo
+  std::deque<uint8_t> rx_bytes;
+  // Number of cycles during which the cycle was dropped while busy
+  uint32_t cyc_drops;
+  uint32_t tx_done_count, rx_done_count;
+
+  void reset() {
+    this->_nop();
+
+    this->core->rst_i = 1;
+    for(int i = 0; i < 5; i++) {
+      this->tick();
+    }
+    this->core->rst_i = 0;
+
+    for(int i = 0; i < MEM_SIZE; i++) {
+      mem[i] = i;
+    }
+    accesses.clear();
+    tx_pushes.clear();
+    rx_bytes.clear();
+    cyc_drops = 0;
+    tx_done_count = 0;
+    rx_done_count = 0;
+
+    Testbench<Vtb_dma_master>::reset();
+  }
+  
+  void _nop() {
+    core->write_data_i = 0;
+    core->tx_addr_write_i = 0;
+    core->tx_len_write_i = 0;
+    core->rx_addr_write_i = 0;
+    core->rx_len_write_i = 0;
+    core->tx_fifo_ready_i = 1;
+    core->rx_fifo_ready_i = 1;
+    core->rx_fifo_count_i = 0;
+    core->rx_fifo_data_i = 0;
+    core->wbm_dat_i = 0;
+    core->wbm_ack_i = 0;
+    core->wbm_stall_i = 0;
+  }
+
+  void write_reg(uint8_t reg, uint32_t value) {
+    core->write_data_i = value;
+    core->tx_addr_write_i = (reg == 0);
+    core->tx_len_write_i = (reg == 1);
+    core->rx_addr_write_i = (reg == 2);
+    core->rx_len_write_i = (reg == 3);
+    this->bus_tick();
+    core->write_data_i = 0;
+    core->tx_addr_write_i = 0;
+    core->tx_len_write_i = 0;
+    core->rx_addr_write_i = 0;
+    core->rx_len_write_i = 0;
+  }
+
+  /**
+   * Ticks the design along with a memory model acknowledging each access
+   * the cycle after it is accepted, and a receive fifo model.
+   */
+  void bus_tick() {
+    // Receive fifo outputs
+    uint32_t head = 0;
+    for(size_t i = 0; i < 4 && i < rx_bytes.size(); i++) {
+      head |= (uint32_t)rx_bytes[i] << (i * 8);
+    }
+    core->rx_fifo_count_i = rx_bytes.size();
+    core->rx_fifo_data_i = head;
+    core->eval();
+
+    bool accepted = core->wbm_stb_o && !core->wbm_stall_i;
+    Access req = {core->wbm_adr_o, core->wbm_dat_o, (bool)core->wbm_we_o, core->wbm_sel_o};
+    if(core->tx_fifo_write_o) {
+      tx_pushes.push_back(core->tx_fifo_wdata_o);
+    }
+    uint8_t pops = core->rx_fifo_read_o;
+
+    this->tick();
+
+    for(uint8_t i = 0; i < pops && !rx_bytes.empty(); i++) {
+      rx_bytes.pop_front();
+    }
+
+    core->wbm_ack_i = 0;
+    if(accepted) {
+      core->wbm_ack_i = 1;
+      uint32_t offset = req.adr - MEM_BASE;
+      if(req.we) {
+        for(int i = 0; i < 4; i++) {
+          if((req.sel >> i) & 1) {
+            mem[offset + i] = (req.dat >> (i * 8)) & 0xFF;
+          }
+        }
+      } else {
+        core->wbm_dat_i = mem[offset] | (mem[offset+1] << 8) | (mem[offset+2] << 16) | ((uint32_t)mem[offset+3] << 24);
+      }
+      accesses.push_back(req);
+    }
+
+    tx_done_count += core->tx_done_o;
+    rx_done_count += core->rx_done_o;
+  }
+};
+
+void tb_dma_master_idle(TB_Dma_master * tb) {
+  Vtb_dma_master * core = tb->core;
+  core->testcase = T_IDLE;
+
+  //=================================
+  //      Tick (0)
+  
+  tb->reset();
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  tb->check(COND_state, (core->tb_dma_master->dut->state_q == S_IDLE));
+  tb->check(COND_bus,   (core->wbm_cyc_o == 0) &&
+                        (core->wbm_stb_o == 0));
+  tb->check(COND_fifo,  (core->tx_fifo_write_o == 0) &&
+                        (core->rx_fifo_read_o == 0));
+  tb->check(COND_done,  (core->tx_done_o == 0) &&
+                        (core->rx_done_o == 0));
+
+  //=================================
+  //      Tick (1-10)
+  
+  // Received bytes are not popped when the receive channel is not started
+  tb->rx_bytes.push_back(0xAB);
+  for(int i = 0; i < 10; i++) {
+    tb->bus_tick();
+  }
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  tb->check(COND_state, (core->tb_dma_master->dut->state_q == S_IDLE));
+  tb->check(COND_bus,   (core->wbm_cyc_o == 0) &&
+                        (tb->accesses.size() == 0));
+  tb->check(COND_fifo,  (tb->tx_pushes.size() == 0) &&
+                        (tb->rx_bytes.size() == 1));
+  tb->check(COND_done,  (tb->tx_done_count == 0) &&
+                        (tb->rx_done_count == 0));
+
+  //`````````````````````````````````
+  //      Formal Checks 
+  
+  CHECK("tb_dma_master.idle.01",
+      tb->conditions[COND_state],
+      "Failed to implement the state machine", tb->err_cycles[COND_state]);
+
+  CHECK("tb_dma_master.idle.02",
+      tb->conditions[COND_bus],
+      "Failed to implement the wishbone master interface", tb->err_cycles[COND_bus]);
+
+  CHECK("tb_dma_master.idle.03",
+      tb->conditions[COND_fifo],
+      "Failed to implement the fifo interface", tb->err_cycles[COND_fifo]);
+
+  CHECK("tb_dma_master.idle.04",
+      tb->conditions[COND_done],
+      "Failed to implement the done signals", tb->err_cycles[COND_done]);
+}
+
+void tb_dma_master_tx(TB_Dma_master * tb) {
+  Vtb_dma_master * core = tb->core;
+  core->testcase = T_TX;
+
+  //=================================
+  //      Tick (0)
+  
+  tb->reset();
+
+  //=================================
+  //      Tick (1-2)
+  
+  // 6 bytes from an unaligned address, spanning two words
+  tb->write_reg(0, MEM_BASE + 1);
+  tb->write_reg(1, 6);
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  tb->check(COND_state, (core->tb_dma_master->dut->state_q == S_TX_REQ));
+  tb->check(COND_bus,   (core->wbm_cyc_o == 1) &&
+                        (core->wbm_stb_o == 1) &&
+                        (core->wbm_we_o == 0) &&
+                        (core->wbm_adr_o == MEM_BASE) &&
+                        (core->wbm_sel_o == 0xE));
+
+  //=================================
+  //      Tick (3-...)
+  
+  for(int i = 0; i < 20; i++) {
+    tb->bus_tick();
+    // The cycle is held between consecutive accesses
+    if(tb->tx_done_count == 0 && core->wbm_cyc_o == 0) {
+      tb->cyc_drops += 1;
+    }
+  }
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  tb->check(COND_bus,   (tb->accesses.size() == 2) &&
+                        (tb->accesses[0].sel == 0xE) &&
+                        (tb->accesses[1].adr == MEM_BASE + 4) &&
+                        (tb->accesses[1].sel == 0x7) &&
+                        (tb->cyc_drops == 0) &&
+                        (core->wbm_cyc_o == 0));
+  // Each fetched word is pushed with its byte lanes
+  tb->check(COND_fifo,  (tb->tx_pushes.size() == 2) &&
+                        (tb->tx_pushes[0] == ((0xEULL << 32) | 0x03020100)) &&
+                        (tb->tx_pushes[1] == ((0x7ULL << 32) | 0x07060504)));
+  tb->check(COND_done,  (tb->tx_done_count == 1) &&
+                        (tb->rx_done_count == 0) &&
+                        (core->tx_len_o == 0) &&
+                        (core->tx_addr_o == MEM_BASE + 7));
+
+  //=================================
+  //      Tick (...)
+  
+  // A full fifo delays the pushes
+  tb->reset();
+  core->tx_fifo_ready_i = 0;
+  tb->write_reg(0, MEM_BASE);
+  tb->write_reg(1, 8);
+  for(int i = 0; i < 10; i++) {
+    tb->bus_tick();
+  }
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  // A single word is fetched and kept until it can be pushed
+  tb->check(COND_bus,   (tb->accesses.size() == 1));
+  tb->check(COND_fifo,  (tb->tx_pushes.size() == 0));
+
+  //=================================
+  //      Tick (...)
+  
+  core->tx_fifo_ready_i = 1;
+  for(int i = 0; i < 10; i++) {
+    tb->bus_tick();
+  }
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  tb->check(COND_bus,   (tb->accesses.size() == 2));
+  tb->check(COND_fifo,  (tb->tx_pushes.size() == 2) &&
+                        (tb->tx_pushes[0] == ((0xFULL << 32) | 0x03020100)) &&
+                        (tb->tx_pushes[1] == ((0xFULL << 32) | 0x07060504)));
+  tb->check(COND_done,  (tb->tx_done_count == 1));
+
+  //`````````````````````````````````
+  //      Formal Checks 
+  
+  CHECK("tb_dma_master.tx.01",
+      tb->conditions[COND_state],
+      "Failed to implement the state machine", tb->err_cycles[COND_state]);
+
+  CHECK("tb_dma_master.tx.02",
+      tb->conditions[COND_bus],
+      "Failed to implement the wishbone master interface", tb->err_cycles[COND_bus]);
+
+  CHECK("tb_dma_master.tx.03",
+      tb->conditions[COND_fifo],
+      "Failed to implement the fifo interface", tb->err_cycles[COND_fifo]);
+
+  CHECK("tb_dma_master.tx.04",
+      tb->conditions[COND_done],
+      "Failed to implement the done signals", tb->err_cycles[COND_done]);
+}
+
+void tb_dma_master_rx(TB_Dma_master * tb) {
+  Vtb_dma_master * core = tb->core;
+  core->testcase = T_RX;
+
+  //=================================
+  //      Tick (0)
+  
+  tb->reset();
+
+  //=================================
+  //      Tick (1-2)
+  
+  // 5 bytes to an unaligned address, spanning two words
+  tb->write_reg(2, MEM_BASE + 0x22);
+  tb->write_reg(3, 5);
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  // Nothing is written before bytes are received
+  tb->check(COND_state, (core->tb_dma_master->dut->state_q == S_IDLE));
+
+  //=================================
+  //      Tick (3-...)
+  
+  uint8_t data[] = {0x11, 0x22, 0x33, 0x44, 0x55};
+  for(int i = 0; i < 5; i++) {
+    tb->rx_bytes.push_back(data[i]);
+  }
+  for(int i = 0; i < 20; i++) {
+    tb->bus_tick();
+    if(tb->rx_done_count == 0 && tb->accesses.size() > 0 && core->wbm_cyc_o == 0) {
+      tb->cyc_drops += 1;
+    }
+  }
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  tb->check(COND_bus,   (tb->accesses.size() == 2) &&
+                        (tb->accesses[0].we == 1) &&
+                        (tb->accesses[0].adr == MEM_BASE + 0x20) &&
+                        (tb->accesses[0].sel == 0xC) &&
+                        (tb->accesses[1].adr == MEM_BASE + 0x24) &&
+                        (tb->accesses[1].sel == 0x7) &&
+                        (tb->cyc_drops == 0));
+  tb->check(COND_fifo,  (tb->rx_bytes.size() == 0) &&
+                        (tb->mem[0x21] == 0x21) &&
+                        (tb->mem[0x22] == 0x11) &&
+                        (tb->mem[0x23] == 0x22) &&
+                        (tb->mem[0x24] == 0x33) &&
+                        (tb->mem[0x25] == 0x44) &&
+                        (tb->mem[0x26] == 0x55) &&
+                        (tb->mem[0x27] == 0x27));
+  tb->check(COND_done,  (tb->rx_done_count == 1) &&
+                        (tb->tx_done_count == 0) &&
+                        (core->rx_len_o == 0));
+
+  //`````````````````````````````````
+  //      Formal Checks 
+  
+  CHECK("tb_dma_master.rx.01",
+      tb->conditions[COND_state],
+      "Failed to implement the state machine", tb->err_cycles[COND_state]);
+
+  CHECK("tb_dma_master.rx.02",
+      tb->conditions[COND_bus],
+      "Failed to implement the wishbone master interface", tb->err_cycles[COND_bus]);
+
+  CHECK("tb_dma_master.rx.03",
+      tb->conditions[COND_fifo],
+      "Failed to implement the fifo interface", tb->err_cycles[COND_fifo]);
+
+  CHECK("tb_dma_master.rx.04",
+      tb->conditions[COND_done],
+      "Failed to implement the done signals", tb->err_cycles[COND_done]);
+}
+
+/**
+ * @brief Start both channels during the same cycle. The receive channel is
+ *        expected to issue its access first.
+ */
+void tb_dma_master_priority(TB_Dma_master * tb) {
+  Vtb_dma_master * core = tb->core;
+  core->testcase = T_PRIORITY;
+
+  //=================================
+  //      Tick (0)
+  
+  tb->reset();
+
+  //=================================
+  //      Tick (1-3)
+  
+  // The receive channel waits for received bytes
+  tb->write_reg(2, MEM_BASE + 0x40);
+  tb->write_reg(3, 2);
+  tb->write_reg(0, MEM_BASE);
+
+  //=================================
+  //      Tick (4)
+  
+  // Bytes are received while the transmit channel is started
+  tb->rx_bytes.push_back(0x11);
+  tb->rx_bytes.push_back(0x22);
+  tb->write_reg(1, 4);
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  tb->check(COND_state, (core->tb_dma_master->dut->state_q == S_RX_REQ));
+  tb->check(COND_bus,   (core->wbm_stb_o == 1) &&
+                        (core->wbm_we_o == 1) &&
+                        (core->wbm_adr_o == MEM_BASE + 0x40));
+
+  //=================================
+  //      Tick (5-...)
+  
+  for(int i = 0; i < 20; i++) {
+    tb->bus_tick();
+  }
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  // The transmit access follows the receive access
+  tb->check(COND_bus,   (tb->accesses.size() == 2) &&
+                        (tb->accesses[0].we == 1) &&
+                        (tb->accesses[0].sel == 0x3) &&
+                        (tb->accesses[1].we == 0) &&
+                        (tb->accesses[1].adr == MEM_BASE) &&
+                        (tb->accesses[1].sel == 0xF));
+  tb->check(COND_fifo,  (tb->rx_bytes.size() == 0) &&
+                        (tb->mem[0x40] == 0x11) &&
+                        (tb->mem[0x41] == 0x22) &&
+                        (tb->tx_pushes.size() == 1));
+  tb->check(COND_done,  (tb->rx_done_count == 1) &&
+                        (tb->tx_done_count == 1));
+
+  //`````````````````````````````````
+  //      Formal Checks 
+  
+  CHECK("tb_dma_master.priority.01",
+      tb->conditions[COND_state],
+      "Failed to implement the state machine", tb->err_cycles[COND_state]);
+
+  CHECK("tb_dma_master.priority.02",
+      tb->conditions[COND_bus],
+      "Failed to implement the channel priority", tb->err_cycles[COND_bus]);
+
+  CHECK("tb_dma_master.priority.03",
+      tb->conditions[COND_fifo],
+      "Failed to implement the fifo interface", tb->err_cycles[COND_fifo]);
+
+  CHECK("tb_dma_master.priority.04",
+      tb->conditions[COND_done],
+      "Failed to implement the done signals", tb->err_cycles[COND_done]);
+}
+
+int main(int argc, char ** argv, char ** env) {
+  srand(time(NULL));
+  Verilated::traceEverOn(true);
+
+  bool verbose = parse_verbose(argc, argv);
+
+  TB_Dma_master * tb = new TB_Dma_master;
+  tb->open_trace("waves/dma_master.vcd");
+  tb->open_testdata("testdata/dma_master.csv");
+  tb->set_debug_log(verbose);
+  tb->init_conditions(__CondIdEnd);
+
+  /************************************************************/
+
+  tb_dma_master_idle(tb);
+
+  tb_dma_master_tx(tb);
+  tb_dma_master_rx(tb);
+  tb_dma_master_priority(tb);
+
+  /************************************************************/
+
+  printf("[DMA_MASTER]: ");
+  if(tb->success) {
+    printf("Done\n");
+  } else {
+    printf("Failed\n");
+  }
+
+  delete tb;
+  exit(EXIT_SUCCESS);
+}
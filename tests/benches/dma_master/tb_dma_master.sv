@@ -0,0 +1,108 @@
+/*           __        _
+ *  ________/ /  ___ _(_)__  ___
+ * / __/ __/ _ \/ _ `/ / _ \/ -_)
+ * \__/\__/_//_/\_,_/_/_//_/\__/
+ * 
+ * Copyright (C) Clément Chaine
+ * This file is part of ECAP5-DWBUART <https://github.com/ecap5/ECAP5-DWBUART>
+ *
+ * ECAP5-DWBUART is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ECAP5-DWBUART is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ECAP5-DWBUART.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+module tb_dma_master
+(
+  input   int          testcase,
+
+  input   logic         clk_i,
+  input   logic         rst_i,
+
+  input   logic[31:0]   write_data_i,
+
+  input   logic         tx_addr_write_i,
+  input   logic         tx_len_write_i,
+  output  logic[31:0]   tx_addr_o,
+  output  logic[15:0]   tx_len_o,
+  output  logic         tx_done_o,
+
+  input   logic         rx_addr_write_i,
+  input   logic         rx_len_write_i,
+  output  logic[31:0]   rx_addr_o,
+  output  logic[15:0]   rx_len_o,
+  output  logic         rx_done_o,
+
+  input   logic         tx_fifo_ready_i,
+  output  logic         tx_fifo_write_o,
+  output  logic[35:0]   tx_fifo_wdata_o,
+
+  input   logic         rx_fifo_ready_i,
+  input   logic[4:0]    rx_fifo_count_i,
+  input   logic[31:0]   rx_fifo_data_i,
+  output  logic[2:0]    rx_fifo_read_o,
+
+  output  logic[31:0]   wbm_adr_o,
+  output  logic[31:0]   wbm_dat_o,
+  input   logic[31:0]   wbm_dat_i,
+  output  logic         wbm_we_o,
+  output  logic[3:0]    wbm_sel_o,
+  output  logic         wbm_stb_o,
+  input   logic         wbm_ack_i,
+  output  logic         wbm_cyc_o,
+  input   logic         wbm_stall_i
+);
+
+dma_master #(
+  .RX_CNT_WIDTH (5)
+) dut (
+  .clk_i           (clk_i),
+  .rst_i           (rst_i),
+
+  .write_data_i    (write_data_i),
+
+  .tx_addr_write_i (tx_addr_write_i),
+  .tx_len_write_i  (tx_len_write_i),
+  .tx_addr_o       (tx_addr_o),
+  .tx_len_o        (tx_len_o),
+  .tx_done_o       (tx_done_o),
+
+  .rx_addr_write_i (rx_addr_write_i),
+  .rx_len_write_i  (rx_len_write_i),
+  .rx_addr_o       (rx_addr_o),
+  .rx_len_o        (rx_len_o),
+  .rx_done_o       (rx_done_o),
+
+  .tx_fifo_ready_i (tx_fifo_ready_i),
+  .tx_fifo_write_o (tx_fifo_write_o),
+  .tx_fifo_wdata_o (tx_fifo_wdata_o),
+
+  .rx_fifo_ready_i (rx_fifo_ready_i),
+  .rx_fifo_count_i (rx_fifo_count_i),
+  .rx_fifo_data_i  (rx_fifo_data_i),
+  .rx_fifo_read_o  (rx_fifo_read_o),
+
+  .wbm_adr_o       (wbm_adr_o),
+  .wbm_dat_o       (wbm_dat_o),
+  .wbm_dat_i       (wbm_dat_i),
+  .wbm_we_o        (wbm_we_o),
+  .wbm_sel_o       (wbm_sel_o),
+  .wbm_stb_o       (wbm_stb_o),
+  .wbm_ack_i       (wbm_ack_i),
+  .wbm_cyc_o       (wbm_cyc_o),
+  .wbm_stall_i     (wbm_stall_i)
+);
+
+endmodule // tb_dma_master
+
+`verilator_config
+
+public -module "dma_master" -var "state_q"
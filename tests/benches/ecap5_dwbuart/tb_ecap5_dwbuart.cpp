@@ -32,12 +32,21 @@
 #include "Vtb_ecap5_dwbuart_ecap5_dwbuart.h"
 #include "testbench.h"
 
+// Fifo depths of the instantiated dut
+#define RX_FIFO_DEPTH 2
+#define TX_FIFO_DEPTH 2
+
 enum CondId {
   COND_reset,
   COND_mem,
   COND_rx,
   COND_tx,
   COND_registers,
+  COND_irq,
+  COND_rts,
+  COND_dma,
+  COND_stream,
+  COND_de,
   __CondIdEnd
 };
 
@@ -52,7 +61,28 @@ enum TestcaseId {
   T_RACE_SR               = 8,
   T_RACE_TXDR             = 9,
   T_RACE_RXDR             = 10,
-  T_ERROR_RETENTION       = 11
+  T_ERROR_RETENTION       = 11,
+  T_RX_FIFO               = 12,
+  T_TX_FIFO               = 13,
+  T_IRQ                   = 14,
+  T_TXPDR                 = 15,
+  T_RXPDR                 = 16,
+  T_RX_TIMEOUT            = 17,
+  T_FALSE_START           = 18,
+  T_AUTOBAUD              = 19,
+  T_FLOW_CONTROL          = 20,
+  T_SHADOW_CR             = 21,
+  T_DMA                   = 22,
+  T_DMA_MASTER            = 23,
+  T_STREAM                = 24,
+  T_BREAK                 = 25,
+  T_MPE                   = 26,
+  T_DE                    = 27,
+  T_LOOPBACK              = 28,
+  T_STATISTICS            = 29,
+  T_TIMESTAMP             = 30,
+  T_CHAR_MATCH            = 31,
+  T_CRC                   = 32
 };
 
 enum StateId {
@@ -80,6 +110,13 @@ public:
     this->core->wb_stb_i = 0;
     this->core->wb_cyc_i = 0;
 
+    this->core->wbm_dat_i = 0;
+    this->core->wbm_ack_i = 0;
+    this->core->wbm_stall_i = 0;
+
+    this->core->stream_tx_valid_i = 0;
+    this->core->stream_tx_data_i = 0;
+    this->core->stream_rx_ready_i = 0;
   }
 
   void read(uint32_t addr) {
@@ -92,27 +129,44 @@ public:
   }
 
   void write(uint32_t addr, uint32_t data) {
+    this->write(addr, data, 0xF);
+  }
+
+  void write(uint32_t addr, uint32_t data, uint8_t sel) {
     this->core->wb_adr_i = addr;
     this->core->wb_dat_i = data;
     this->core->wb_we_i = 1;
-    this->core->wb_sel_i = 0xF;
+    this->core->wb_sel_i = sel;
     this->core->wb_stb_i = 1;
     this->core->wb_cyc_i = 1;
   }
 
   uint32_t uart_sr() {
     uint32_t reg = 0;
+    reg |= core->tb_ecap5_dwbuart->dut->sr_tc << 12;
+    reg |= core->tb_ecap5_dwbuart->dut->sr_cmf_q << 11;
+    reg |= core->tb_ecap5_dwbuart->dut->sr_adm_q << 10;
+    reg |= core->tb_ecap5_dwbuart->dut->sr_brk_q << 9;
+    reg |= core->tb_ecap5_dwbuart->dut->cr_pending_q << 8;
+    reg |= core->tb_ecap5_dwbuart->dut->sr_nf_q << 7;
+    reg |= core->tb_ecap5_dwbuart->dut->sr_rto_q << 6;
+    reg |= core->tb_ecap5_dwbuart->dut->sr_txf << 5;
     reg |= core->tb_ecap5_dwbuart->dut->sr_pe_q << 4;
     reg |= core->tb_ecap5_dwbuart->dut->sr_fe_q << 3;
     reg |= core->tb_ecap5_dwbuart->dut->sr_rxoe_q << 2;
-    reg |= core->tb_ecap5_dwbuart->dut->sr_txe_q << 1;
-    reg |= core->tb_ecap5_dwbuart->dut->sr_rxne_q;
+    reg |= core->tb_ecap5_dwbuart->dut->sr_txe << 1;
+    reg |= core->tb_ecap5_dwbuart->dut->sr_rxne;
     return reg;
   }
 
   uint32_t uart_cr() {
     uint32_t reg = 0;
     reg |= core->tb_ecap5_dwbuart->dut->cr_acc_incr_q << 16;
+    reg |= core->tb_ecap5_dwbuart->dut->cr_acc_frac_q << 8;
+    reg |= core->tb_ecap5_dwbuart->dut->cr_rtse_q << 7;
+    reg |= core->tb_ecap5_dwbuart->dut->cr_ctse_q << 6;
+    reg |= core->tb_ecap5_dwbuart->dut->cr_abe_q << 5;
+    reg |= core->tb_ecap5_dwbuart->dut->cr_ovs_q << 4;
     reg |= core->tb_ecap5_dwbuart->dut->cr_ds_q << 3;
     reg |= core->tb_ecap5_dwbuart->dut->cr_s_q << 2;
     reg |= core->tb_ecap5_dwbuart->dut->cr_p_q;
@@ -120,11 +174,11 @@ public:
   }
 
   uint32_t uart_rxdr() {
-    return core->tb_ecap5_dwbuart->dut->rxdr_rxd_q;
+    return core->tb_ecap5_dwbuart->dut->rx_fifo_data & 0xFF;
   }
 
   uint32_t uart_txdr() {
-    return core->tb_ecap5_dwbuart->dut->txdr_txd_q;
+    return core->tb_ecap5_dwbuart->dut->tx_data;
   }
 
   void generate_read() {
@@ -241,7 +295,10 @@ public:
     this->n_tick(1 + 2 + 3);
   }
 
-  void generate_rxoe() {
+  void generate_frames(uint32_t num_frames) {
+    // Data written to UART_TXDR for each frame
+    uint32_t data[] = {0xA5FA5FA5, 0xA5FAA5FA, 0xA5FA5A5A};
+
     // (2**16)/4 = 16384 = 1 bit every 4 clk cycles
     uint32_t cr = (16384 << 16) | (1 << 3) | 1;
     this->write(0x4, cr);
@@ -255,32 +312,34 @@ public:
     this->_nop();
     this->tick();
 
-    this->write(0xC, 0xA5FA5FA5);
-    this->tick();
-
-    this->_nop();
-    this->core->wb_cyc_i = 1;
-    this->tick();
-
-    this->_nop();
-    this->core->wb_cyc_i = 0;
     // 1 start bit, 8 data bits, 1 parity bit, 0.5 stop bit
     // the receive is valid at the half of the stop bit
     uint32_t number_of_tx_bits = (1 + 8 + 1 + 1 + 0.5) * 4;
-    // This call is shifted by 1 tick from the emission start,
-    this->n_tick(number_of_tx_bits - 1);
 
-    this->write(0xC, 0xA5FAA5FA);
-    this->tick();
+    for(uint32_t i = 0; i < num_frames; i++) {
+      this->write(0xC, data[i]);
+      this->tick();
 
-    this->_nop();
-    this->core->wb_cyc_i = 1;
-    this->tick();
+      this->_nop();
+      this->core->wb_cyc_i = 1;
+      this->tick();
 
-    this->_nop();
-    this->core->wb_cyc_i = 0;
-    // and this function shall put its caller the cycle before the valid signal is asserted
-    this->n_tick(number_of_tx_bits - 2);
+      this->_nop();
+      this->core->wb_cyc_i = 0;
+
+      if(i < (num_frames - 1)) {
+        // This call is shifted by 1 tick from the emission start,
+        this->n_tick(number_of_tx_bits - 1);
+      } else {
+        // and this function shall put its caller the cycle before the valid signal is asserted
+        this->n_tick(number_of_tx_bits - 2);
+      }
+    }
+  }
+
+  void generate_rxoe() {
+    // One more frame than what the receive fifo can hold
+    this->generate_frames(RX_FIFO_DEPTH + 1);
   }
 };
 
@@ -300,10 +359,10 @@ void tb_ecap5_dwbuart_idle(TB_Ecap5_dwbuart * tb) {
   tb->check(COND_mem,       (core->tb_ecap5_dwbuart->dut->mem_read == 0) &&
                             (core->tb_ecap5_dwbuart->dut->mem_write == 0));
   tb->check(COND_rx,        (core->tb_ecap5_dwbuart->dut->rx_valid == 0));
-  tb->check(COND_tx,        (core->tb_ecap5_dwbuart->dut->tx_transmit_q == 0) &&
+  tb->check(COND_tx,        (core->tb_ecap5_dwbuart->dut->tx_transmit == 0) &&
                             (core->tb_ecap5_dwbuart->dut->tx_done == 0) &&
                             (core->uart_tx_o == 1));
-  tb->check(COND_registers, (tb->uart_sr() == 2) &&
+  tb->check(COND_registers, (tb->uart_sr() == ((1 << 12) | 2)) &&
                             (tb->uart_cr() == 0) &&
                             (tb->uart_rxdr() == 0) &&
                             (tb->uart_txdr() == 0));
@@ -320,10 +379,10 @@ void tb_ecap5_dwbuart_idle(TB_Ecap5_dwbuart * tb) {
   tb->check(COND_mem,       (core->tb_ecap5_dwbuart->dut->mem_read == 0) &&
                             (core->tb_ecap5_dwbuart->dut->mem_write == 0));
   tb->check(COND_rx,        (core->tb_ecap5_dwbuart->dut->rx_valid == 0));
-  tb->check(COND_tx,        (core->tb_ecap5_dwbuart->dut->tx_transmit_q == 0) &&
+  tb->check(COND_tx,        (core->tb_ecap5_dwbuart->dut->tx_transmit == 0) &&
                             (core->tb_ecap5_dwbuart->dut->tx_done == 0) &&
                             (core->uart_tx_o == 1));
-  tb->check(COND_registers, (tb->uart_sr() == 2) &&
+  tb->check(COND_registers, (tb->uart_sr() == ((1 << 12) | 2)) &&
                             (tb->uart_cr() == 0) &&
                             (tb->uart_rxdr() == 0) &&
                             (tb->uart_txdr() == 0));
@@ -340,10 +399,10 @@ void tb_ecap5_dwbuart_idle(TB_Ecap5_dwbuart * tb) {
   tb->check(COND_mem,       (core->tb_ecap5_dwbuart->dut->mem_read == 0) &&
                             (core->tb_ecap5_dwbuart->dut->mem_write == 0));
   tb->check(COND_rx,        (core->tb_ecap5_dwbuart->dut->rx_valid == 0));
-  tb->check(COND_tx,        (core->tb_ecap5_dwbuart->dut->tx_transmit_q == 0) &&
+  tb->check(COND_tx,        (core->tb_ecap5_dwbuart->dut->tx_transmit == 0) &&
                             (core->tb_ecap5_dwbuart->dut->tx_done == 0) &&
                             (core->uart_tx_o == 1));
-  tb->check(COND_registers, (tb->uart_sr() == 2) &&
+  tb->check(COND_registers, (tb->uart_sr() == ((1 << 12) | 2)) &&
                             (tb->uart_cr() == 0) &&
                             (tb->uart_rxdr() == 0) &&
                             (tb->uart_txdr() == 0));
@@ -384,7 +443,8 @@ void tb_ecap5_dwbuart_write_cr(TB_Ecap5_dwbuart * tb) {
   //`````````````````````````````````
   //      Set inputs
   
-  tb->write(0x4, 0xA5FA5FA5);
+  // The auto-baud mode and the flow control are left disabled
+  tb->write(0x4, 0xA5FA5F05);
 
   //=================================
   //      Tick (1)
@@ -396,7 +456,7 @@ void tb_ecap5_dwbuart_write_cr(TB_Ecap5_dwbuart * tb) {
   
   tb->check(COND_reset,     (core->tb_ecap5_dwbuart->dut->frontend_rst == 1));
   tb->check(COND_mem,       (core->wb_ack_o == 1));
-  tb->check(COND_registers, (tb->uart_cr() == 0xA5FA0005));
+  tb->check(COND_registers, (tb->uart_cr() == 0xA5FA5F05));
 
   //`````````````````````````````````
   //      Set inputs
@@ -490,11 +550,12 @@ void tb_ecap5_dwbuart_write_txdr(TB_Ecap5_dwbuart * tb) {
   //`````````````````````````````````
   //      Checks 
   
-  tb->check(COND_registers, ((tb->uart_sr() & 0x2) == 0));
+  tb->check(COND_registers, ((tb->uart_sr() & 0x2) == 0) &&
+                            (((tb->uart_sr() >> 12) & 0x1) == 0));
   tb->check(COND_reset,     (core->tb_ecap5_dwbuart->dut->frontend_rst == 0));
   tb->check(COND_mem,       (core->wb_ack_o == 1));
   tb->check(COND_registers, (tb->uart_txdr() == 0x000000A5));
-  tb->check(COND_tx,        (core->tb_ecap5_dwbuart->dut->tx_transmit_q == 1));
+  tb->check(COND_tx,        (core->tb_ecap5_dwbuart->dut->tx_transmit == 1));
 
   //`````````````````````````````````
   //      Set inputs
@@ -524,6 +585,8 @@ void tb_ecap5_dwbuart_write_txdr(TB_Ecap5_dwbuart * tb) {
   //      Checks 
   
   tb->check(COND_tx, (core->tb_ecap5_dwbuart->dut->tx_done == 1));
+  tb->check(COND_registers, (tb->uart_sr() & 0x2) &&
+                            (((tb->uart_sr() >> 12) & 0x1) == 1));
 
   //=================================
   //      Tick (50)
@@ -661,17 +724,17 @@ void tb_ecap5_dwbuart_rxoe(TB_Ecap5_dwbuart * tb) {
   tb->reset();
 
   //=================================
-  //      Tick (1-96)
+  //      Tick (1-142)
   
   tb->generate_rxoe();
 
   //=================================
-  //      Tick (97)
+  //      Tick (143)
   
   tb->tick();
 
   //=================================
-  //      Tick (98)
+  //      Tick (144)
   
   tb->tick();
 
@@ -681,15 +744,16 @@ void tb_ecap5_dwbuart_rxoe(TB_Ecap5_dwbuart * tb) {
   tb->check(COND_rx, (core->tb_ecap5_dwbuart->dut->rx_valid == 1));
 
   //=================================
-  //      Tick (99)
+  //      Tick (145)
   
   tb->tick();
 
   //`````````````````````````````````
   //      Checks 
   
+  // The last frame is dropped as the fifo is full
   tb->check(COND_registers, ((tb->uart_sr() >> 2) & 0x1) &&
-                             (tb->uart_rxdr() == 0xFA));
+                             (tb->uart_rxdr() == 0xA5));
 
   //`````````````````````````````````
   //      Set inputs
@@ -697,7 +761,7 @@ void tb_ecap5_dwbuart_rxoe(TB_Ecap5_dwbuart * tb) {
   tb->read(0x8);
 
   //=================================
-  //      Tick (100)
+  //      Tick (146)
   
   tb->tick();
 
@@ -705,9 +769,9 @@ void tb_ecap5_dwbuart_rxoe(TB_Ecap5_dwbuart * tb) {
   //      Checks 
   
   tb->check(COND_rx, (core->tb_ecap5_dwbuart->dut->rx_valid == 0));
-  tb->check(COND_mem, (core->tb_ecap5_dwbuart->dut->mem_read_data_q == 0xFA));
+  tb->check(COND_mem, (core->tb_ecap5_dwbuart->dut->mem_read_data_q == 0xA5));
   tb->check(COND_registers, ((tb->uart_sr() >> 2) & 0x1) &&
-                             (tb->uart_rxdr() == 0x0));
+                             (tb->uart_rxdr() == 0xFA));
 
   //`````````````````````````````````
   //      Set inputs
@@ -716,7 +780,7 @@ void tb_ecap5_dwbuart_rxoe(TB_Ecap5_dwbuart * tb) {
   core->wb_cyc_i = 1;
 
   //=================================
-  //      Tick (101)
+  //      Tick (147)
   
   tb->tick();
 
@@ -726,7 +790,7 @@ void tb_ecap5_dwbuart_rxoe(TB_Ecap5_dwbuart * tb) {
   tb->_nop();
 
   //=================================
-  //      Tick (102)
+  //      Tick (148)
   
   tb->tick();
 
@@ -738,7 +802,7 @@ void tb_ecap5_dwbuart_rxoe(TB_Ecap5_dwbuart * tb) {
   uint32_t sr = tb->uart_sr();
 
   //=================================
-  //      Tick (103)
+  //      Tick (149)
   
   tb->tick();
 
@@ -755,7 +819,7 @@ void tb_ecap5_dwbuart_rxoe(TB_Ecap5_dwbuart * tb) {
   core->wb_cyc_i = 1;
 
   //=================================
-  //      Tick (104)
+  //      Tick (150)
   
   tb->tick();
 
@@ -765,7 +829,7 @@ void tb_ecap5_dwbuart_rxoe(TB_Ecap5_dwbuart * tb) {
   tb->_nop();
 
   //=================================
-  //      Tick (105)
+  //      Tick (151)
   
   tb->tick();
 
@@ -1158,7 +1222,7 @@ void tb_ecap5_dwbuart_race_txdr(TB_Ecap5_dwbuart * tb) {
   
   tb->check(COND_registers, ((tb->uart_sr() & 0x2) == 0));
   tb->check(COND_registers, (tb->uart_txdr() == 0x000000A5));
-  tb->check(COND_tx,        (core->tb_ecap5_dwbuart->dut->tx_transmit_q == 1));
+  tb->check(COND_tx,        (core->tb_ecap5_dwbuart->dut->tx_transmit == 1));
 
   //`````````````````````````````````
   //      Set inputs
@@ -1303,34 +1367,3237 @@ void tb_ecap5_dwbuart_race_rxdr(TB_Ecap5_dwbuart * tb) {
       "Failed to implement the memory-mapped registers", tb->err_cycles[COND_registers]);
 }
 
-int main(int argc, char ** argv, char ** env) {
-  srand(time(NULL));
-  Verilated::traceEverOn(true);
+/**
+ * @brief Receive several frames without reading UART_RXDR.
+ *        The frames are expected to be read back in order without overrun.
+ */
+void tb_ecap5_dwbuart_rx_fifo(TB_Ecap5_dwbuart * tb) {
+  Vtb_ecap5_dwbuart * core = tb->core;
+  core->testcase = T_RX_FIFO;
 
-  bool verbose = parse_verbose(argc, argv);
+  //=================================
+  //      Tick (0)
+  
+  tb->reset();
 
-  TB_Ecap5_dwbuart * tb = new TB_Ecap5_dwbuart;
-  tb->open_trace("waves/ecap5_dwbuart.vcd");
-  tb->open_testdata("testdata/ecap5_dwbuart.csv");
-  tb->set_debug_log(verbose);
-  tb->init_conditions(__CondIdEnd);
+  //=================================
+  //      Tick (1-96)
+  
+  tb->generate_frames(RX_FIFO_DEPTH);
 
-  /************************************************************/
+  //=================================
+  //      Tick (97)
+  
+  tb->tick();
 
-  tb_ecap5_dwbuart_idle(tb);
+  //=================================
+  //      Tick (98)
+  
+  tb->tick();
 
-  tb_ecap5_dwbuart_write_cr(tb);
-  tb_ecap5_dwbuart_write_txdr(tb);
-  tb_ecap5_dwbuart_read_rxdr(tb);
+  //`````````````````````````````````
+  //      Checks 
+  
+  tb->check(COND_rx, (core->tb_ecap5_dwbuart->dut->rx_valid == 1));
 
-  tb_ecap5_dwbuart_rxoe(tb);
-  tb_ecap5_dwbuart_fe(tb);
-  tb_ecap5_dwbuart_pe(tb);
+  //=================================
+  //      Tick (99)
+  
+  tb->tick();
 
-  tb_ecap5_dwbuart_error_retention(tb);
-  tb_ecap5_dwbuart_race_sr(tb);
-  tb_ecap5_dwbuart_race_txdr(tb);
-  tb_ecap5_dwbuart_race_rxdr(tb);
+  //`````````````````````````````````
+  //      Checks 
+  
+  tb->check(COND_registers, (((tb->uart_sr() >> 2) & 0x1) == 0) &&
+                             (tb->uart_sr() & 0x1) &&
+                             (tb->uart_rxdr() == 0xA5));
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  tb->read(0x8);
+
+  //=================================
+  //      Tick (100)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  tb->check(COND_mem, (core->tb_ecap5_dwbuart->dut->mem_read_data_q == 0xA5));
+  tb->check(COND_registers, (tb->uart_sr() & 0x1) &&
+                            (tb->uart_rxdr() == 0xFA));
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  tb->_nop();
+  core->wb_cyc_i = 1;
+
+  //=================================
+  //      Tick (101)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  tb->_nop();
+
+  //=================================
+  //      Tick (102)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  tb->read(0x8);
+
+  //=================================
+  //      Tick (103)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  tb->check(COND_mem, (core->tb_ecap5_dwbuart->dut->mem_read_data_q == 0xFA));
+  tb->check(COND_registers, ((tb->uart_sr() & 0x1) == 0) &&
+                            (tb->uart_rxdr() == 0));
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  tb->_nop();
+  core->wb_cyc_i = 1;
+
+  //=================================
+  //      Tick (104)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  tb->_nop();
+
+  //=================================
+  //      Tick (105)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Formal Checks 
+  
+  CHECK("tb_ecap5_dwbuart.rx_fifo.01",
+      tb->conditions[COND_mem],
+      "Failed to integrate the memory", tb->err_cycles[COND_mem]);
+
+  CHECK("tb_ecap5_dwbuart.rx_fifo.02",
+      tb->conditions[COND_rx],
+      "Failed to integrate the rx frontend", tb->err_cycles[COND_rx]);
+
+  CHECK("tb_ecap5_dwbuart.rx_fifo.03",
+      tb->conditions[COND_registers],
+      "Failed to implement the memory-mapped registers", tb->err_cycles[COND_registers]);
+}
+
+/**
+ * @brief Queue several frames for transmission at once.
+ *        The frames are expected to be sent in order.
+ */
+void tb_ecap5_dwbuart_tx_fifo(TB_Ecap5_dwbuart * tb) {
+  Vtb_ecap5_dwbuart * core = tb->core;
+  core->testcase = T_TX_FIFO;
+
+  uint32_t data[] = {0xA5, 0xFA, 0x5A};
+
+  //=================================
+  //      Tick (0)
+  
+  tb->reset();
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  // (2**16)/4 = 16384 = 1 bit every 4 clk cycles
+  uint32_t cr = (16384 << 16) | (1 << 3) | 1;
+  tb->write(0x4, cr);
+
+  //=================================
+  //      Tick (1)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  tb->_nop();
+  core->wb_cyc_i = 1;
+
+  //=================================
+  //      Tick (2)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  tb->_nop();
+
+  //=================================
+  //      Tick (3)
+  
+  tb->tick();
+
+  //=================================
+  //      Tick (4-12)
+  
+  // The first frame is sent right away while the next ones are queued
+  for(int i = 0; i < (TX_FIFO_DEPTH + 1); i++) {
+    tb->write(0xC, data[i]);
+    tb->tick();
+
+    tb->_nop();
+    core->wb_cyc_i = 1;
+    tb->tick();
+
+    tb->_nop();
+    tb->tick();
+  }
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  tb->check(COND_registers, (((tb->uart_sr() >> 1) & 0x1) == 0) &&
+                            (((tb->uart_sr() >> 5) & 0x1) == 1) &&
+                             (tb->uart_txdr() == 0xFA));
+
+  //=================================
+  //      Tick (13-...)
+  
+  // Each frame is read back through the loopback
+  for(int i = 0; i < (TX_FIFO_DEPTH + 1); i++) {
+    uint32_t timeout = 1000;
+    while((core->tb_ecap5_dwbuart->dut->rx_valid == 0) && (timeout > 0)) {
+      tb->tick();
+      timeout -= 1;
+    }
+    tb->check(COND_rx, (timeout > 0));
+
+    tb->tick();
+
+    tb->read(0x8);
+    tb->tick();
+
+    //`````````````````````````````````
+    //      Checks 
+    
+    tb->check(COND_mem, (core->tb_ecap5_dwbuart->dut->mem_read_data_q == data[i]));
+    tb->check(COND_registers, (((tb->uart_sr() >> 2) & 0x1) == 0));
+
+    tb->_nop();
+    core->wb_cyc_i = 1;
+    tb->tick();
+
+    tb->_nop();
+    tb->tick();
+  }
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  tb->check(COND_registers, (((tb->uart_sr() >> 1) & 0x1) == 1) &&
+                            (((tb->uart_sr() >> 5) & 0x1) == 0));
+
+  //`````````````````````````````````
+  //      Formal Checks 
+  
+  CHECK("tb_ecap5_dwbuart.tx_fifo.01",
+      tb->conditions[COND_mem],
+      "Failed to integrate the memory", tb->err_cycles[COND_mem]);
+
+  CHECK("tb_ecap5_dwbuart.tx_fifo.02",
+      tb->conditions[COND_rx],
+      "Failed to integrate the rx frontend", tb->err_cycles[COND_rx]);
+
+  CHECK("tb_ecap5_dwbuart.tx_fifo.03",
+      tb->conditions[COND_registers],
+      "Failed to implement the memory-mapped registers", tb->err_cycles[COND_registers]);
+}
+
+/**
+ * @brief Enable the RXNE and PE interrupts and check that irq_o
+ *        follows the pending interrupts.
+ */
+void tb_ecap5_dwbuart_irq(TB_Ecap5_dwbuart * tb) {
+  Vtb_ecap5_dwbuart * core = tb->core;
+  core->testcase = T_IRQ;
+
+  //=================================
+  //      Tick (0)
+  
+  tb->reset();
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  // Enable the RXNE and PE interrupts
+  tb->write(0x10, (1 << 4) | 1);
+
+  //=================================
+  //      Tick (1)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  tb->_nop();
+  core->wb_cyc_i = 1;
+
+  //=================================
+  //      Tick (2)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  tb->_nop();
+
+  //=================================
+  //      Tick (3)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  // TXE is pending but not enabled
+  tb->check(COND_irq, (core->irq_o == 0));
+
+  //=================================
+  //      Tick (4-52)
+  
+  tb->generate_read();
+  tb->tick();
+  tb->tick();
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  tb->check(COND_rx,  (tb->uart_sr() & 0x1));
+  tb->check(COND_irq, (core->irq_o == 0));
+
+  //=================================
+  //      Tick (53)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  tb->check(COND_irq, (core->irq_o == 1));
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  tb->read(0x8);
+
+  //=================================
+  //      Tick (54)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  tb->_nop();
+  core->wb_cyc_i = 1;
+
+  //=================================
+  //      Tick (55)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  // RXNE is no longer pending after the fifo is emptied
+  tb->check(COND_irq, (core->irq_o == 0));
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  tb->_nop();
+
+  //=================================
+  //      Tick (56-104)
+  
+  tb->generate_pe();
+  tb->tick();
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  tb->check(COND_irq, (core->tb_ecap5_dwbuart->dut->isr_pe_q == 1) &&
+                      (core->irq_o == 1));
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  // Read the received data to clear RXNE
+  tb->read(0x8);
+
+  //=================================
+  //      Tick (105)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  tb->_nop();
+  core->wb_cyc_i = 1;
+
+  //=================================
+  //      Tick (106)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  tb->_nop();
+
+  //=================================
+  //      Tick (107)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  // The parity error is still pending
+  tb->check(COND_irq, (core->irq_o == 1));
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  // Acknowledge the parity error interrupt
+  tb->write(0x14, (1 << 4));
+
+  //=================================
+  //      Tick (108)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  tb->check(COND_irq, (core->tb_ecap5_dwbuart->dut->isr_pe_q == 0));
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  tb->_nop();
+  core->wb_cyc_i = 1;
+
+  //=================================
+  //      Tick (109)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  tb->check(COND_irq, (core->irq_o == 0));
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  tb->_nop();
+
+  //=================================
+  //      Tick (110)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Formal Checks 
+  
+  CHECK("tb_ecap5_dwbuart.irq.01",
+      tb->conditions[COND_rx],
+      "Failed to integrate the rx frontend", tb->err_cycles[COND_rx]);
+
+  CHECK("tb_ecap5_dwbuart.irq.02",
+      tb->conditions[COND_irq],
+      "Failed to implement the interrupt", tb->err_cycles[COND_irq]);
+}
+
+/**
+ * @brief Write several bytes at once to UART_TXPDR.
+ *        Only the selected byte lanes are expected to be sent, in order.
+ */
+void tb_ecap5_dwbuart_txpdr(TB_Ecap5_dwbuart * tb) {
+  Vtb_ecap5_dwbuart * core = tb->core;
+  core->testcase = T_TXPDR;
+
+  uint32_t data[] = {0xA5, 0x5A, 0x3C};
+
+  //=================================
+  //      Tick (0)
+  
+  tb->reset();
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  // (2**16)/4 = 16384 = 1 bit every 4 clk cycles
+  uint32_t cr = (16384 << 16) | (1 << 3) | 1;
+  tb->write(0x4, cr);
+
+  //=================================
+  //      Tick (1)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  tb->_nop();
+  core->wb_cyc_i = 1;
+
+  //=================================
+  //      Tick (2)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  tb->_nop();
+
+  //=================================
+  //      Tick (3)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  // The second byte lane is not selected
+  tb->write(0x18, 0x3C5AFFA5, 0xD);
+
+  //=================================
+  //      Tick (4)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  tb->check(COND_registers, (((tb->uart_sr() >> 1) & 0x1) == 0) &&
+                             (tb->uart_txdr() == 0xA5));
+  tb->check(COND_tx,        (core->tb_ecap5_dwbuart->dut->tx_transmit == 1));
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  tb->_nop();
+  core->wb_cyc_i = 1;
+
+  //=================================
+  //      Tick (5)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  // The fifo entry is kept until its last byte lane is sent
+  tb->check(COND_registers, (((tb->uart_sr() >> 1) & 0x1) == 0) &&
+                             (tb->uart_txdr() == 0x5A));
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  tb->_nop();
+
+  //=================================
+  //      Tick (6-...)
+  
+  // Each byte is read back through the loopback
+  for(int i = 0; i < 3; i++) {
+    uint32_t timeout = 1000;
+    while((core->tb_ecap5_dwbuart->dut->rx_valid == 0) && (timeout > 0)) {
+      tb->tick();
+      timeout -= 1;
+    }
+    tb->check(COND_rx, (timeout > 0));
+
+    tb->tick();
+
+    tb->read(0x8);
+    tb->tick();
+
+    //`````````````````````````````````
+    //      Checks 
+    
+    tb->check(COND_mem, (core->tb_ecap5_dwbuart->dut->mem_read_data_q == data[i]));
+
+    tb->_nop();
+    core->wb_cyc_i = 1;
+    tb->tick();
+
+    tb->_nop();
+    tb->tick();
+  }
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  tb->check(COND_registers, (((tb->uart_sr() >> 1) & 0x1) == 1) &&
+                             ((tb->uart_sr() & 0x1) == 0));
+
+  //`````````````````````````````````
+  //      Formal Checks 
+  
+  CHECK("tb_ecap5_dwbuart.txpdr.01",
+      tb->conditions[COND_mem],
+      "Failed to integrate the memory", tb->err_cycles[COND_mem]);
+
+  CHECK("tb_ecap5_dwbuart.txpdr.02",
+      tb->conditions[COND_rx],
+      "Failed to integrate the rx frontend", tb->err_cycles[COND_rx]);
+
+  CHECK("tb_ecap5_dwbuart.txpdr.03",
+      tb->conditions[COND_tx],
+      "Failed to integrate the tx frontend", tb->err_cycles[COND_tx]);
+
+  CHECK("tb_ecap5_dwbuart.txpdr.04",
+      tb->conditions[COND_registers],
+      "Failed to implement the memory-mapped registers", tb->err_cycles[COND_registers]);
+}
+
+/**
+ * @brief Drain several received frames with a single read of UART_RXPDR.
+ *        The number of valid byte lanes is given by UART_SR.RXLVL.
+ */
+void tb_ecap5_dwbuart_rxpdr(TB_Ecap5_dwbuart * tb) {
+  Vtb_ecap5_dwbuart * core = tb->core;
+  core->testcase = T_RXPDR;
+
+  //=================================
+  //      Tick (0)
+  
+  tb->reset();
+
+  //=================================
+  //      Tick (1-96)
+  
+  tb->generate_frames(RX_FIFO_DEPTH);
+
+  //=================================
+  //      Tick (97)
+  
+  tb->tick();
+
+  //=================================
+  //      Tick (98)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  tb->check(COND_rx, (core->tb_ecap5_dwbuart->dut->rx_valid == 1));
+
+  //=================================
+  //      Tick (99)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  tb->read(0x0);
+
+  //=================================
+  //      Tick (100)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  tb->check(COND_mem, ((core->tb_ecap5_dwbuart->dut->mem_read_data_q >> 16) == RX_FIFO_DEPTH));
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  tb->_nop();
+  core->wb_cyc_i = 1;
+
+  //=================================
+  //      Tick (101)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  tb->_nop();
+
+  //=================================
+  //      Tick (102)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  tb->read(0x1C);
+
+  //=================================
+  //      Tick (103)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  // The oldest frame is in the lowest byte lane, unused lanes are zero
+  // and the number of valid lanes is in the most significant byte
+  tb->check(COND_mem, (core->tb_ecap5_dwbuart->dut->mem_read_data_q == ((2 << 24) | 0xFAA5)));
+  tb->check(COND_registers, ((tb->uart_sr() & 0x1) == 0) &&
+                            (tb->uart_rxdr() == 0));
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  tb->_nop();
+  core->wb_cyc_i = 1;
+
+  //=================================
+  //      Tick (104)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  tb->_nop();
+
+  //=================================
+  //      Tick (105)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Formal Checks 
+  
+  CHECK("tb_ecap5_dwbuart.rxpdr.01",
+      tb->conditions[COND_mem],
+      "Failed to integrate the memory", tb->err_cycles[COND_mem]);
+
+  CHECK("tb_ecap5_dwbuart.rxpdr.02",
+      tb->conditions[COND_rx],
+      "Failed to integrate the rx frontend", tb->err_cycles[COND_rx]);
+
+  CHECK("tb_ecap5_dwbuart.rxpdr.03",
+      tb->conditions[COND_registers],
+      "Failed to implement the memory-mapped registers", tb->err_cycles[COND_registers]);
+}
+
+/**
+ * @brief Detect the idle line following a received frame.
+ *        The receiver timeout is reported in UART_SR and UART_ISR.
+ */
+void tb_ecap5_dwbuart_rx_timeout(TB_Ecap5_dwbuart * tb) {
+  Vtb_ecap5_dwbuart * core = tb->core;
+  core->testcase = T_RX_TIMEOUT;
+
+  //=================================
+  //      Tick (0)
+  
+  tb->reset();
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  // Timeout after 2 bit times
+  tb->write(0x20, 2);
+
+  //=================================
+  //      Tick (1)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  tb->_nop();
+  core->wb_cyc_i = 1;
+
+  //=================================
+  //      Tick (2)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  // Enable the RTO interrupt
+  tb->write(0x10, (1 << 5));
+
+  //=================================
+  //      Tick (3)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  tb->_nop();
+  core->wb_cyc_i = 1;
+
+  //=================================
+  //      Tick (4)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  tb->_nop();
+
+  //=================================
+  //      Tick (5-...)
+  
+  tb->generate_read();
+  tb->tick();
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  tb->check(COND_rx, (core->tb_ecap5_dwbuart->dut->rx_valid == 1));
+  tb->check(COND_registers, (((tb->uart_sr() >> 6) & 0x1) == 0));
+
+  //=================================
+  //      Tick (...)
+  
+  // 2 bit times of 4 cycles from the middle of the stop bit
+  for(int i = 0; i < 8; i++) {
+    tb->tick();
+  }
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  tb->check(COND_registers, (((tb->uart_sr() >> 6) & 0x1) == 1));
+
+  //=================================
+  //      Tick (...)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  tb->check(COND_irq, (core->irq_o == 1));
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  tb->read(0x0);
+
+  //=================================
+  //      Tick (...)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  tb->check(COND_mem, ((core->tb_ecap5_dwbuart->dut->mem_read_data_q >> 6) & 0x1) == 1);
+  tb->check(COND_registers, (((tb->uart_sr() >> 6) & 0x1) == 0));
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  tb->_nop();
+  core->wb_cyc_i = 1;
+
+  //=================================
+  //      Tick (...)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  // Acknowledge the interrupt
+  tb->write(0x14, (1 << 5));
+
+  //=================================
+  //      Tick (...)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  tb->_nop();
+  core->wb_cyc_i = 1;
+
+  //=================================
+  //      Tick (...)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  tb->check(COND_irq, (core->irq_o == 0));
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  tb->_nop();
+
+  //=================================
+  //      Tick (...)
+  
+  // The timeout is only reported once after the last frame
+  for(int i = 0; i < 100; i++) {
+    tb->tick();
+    tb->check(COND_registers, (((tb->uart_sr() >> 6) & 0x1) == 0));
+  }
+
+  //`````````````````````````````````
+  //      Formal Checks 
+  
+  CHECK("tb_ecap5_dwbuart.rx_timeout.01",
+      tb->conditions[COND_mem],
+      "Failed to integrate the memory", tb->err_cycles[COND_mem]);
+
+  CHECK("tb_ecap5_dwbuart.rx_timeout.02",
+      tb->conditions[COND_rx],
+      "Failed to integrate the rx frontend", tb->err_cycles[COND_rx]);
+
+  CHECK("tb_ecap5_dwbuart.rx_timeout.03",
+      tb->conditions[COND_registers],
+      "Failed to implement the memory-mapped registers", tb->err_cycles[COND_registers]);
+
+  CHECK("tb_ecap5_dwbuart.rx_timeout.04",
+      tb->conditions[COND_irq],
+      "Failed to implement the interrupt", tb->err_cycles[COND_irq]);
+}
+
+/**
+ * @brief Reject a glitch on the receive line and count it in UART_FSCR.
+ */
+void tb_ecap5_dwbuart_false_start(TB_Ecap5_dwbuart * tb) {
+  Vtb_ecap5_dwbuart * core = tb->core;
+  core->testcase = T_FALSE_START;
+
+  //=================================
+  //      Tick (0)
+  
+  tb->reset();
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  // (2**16)/4 = 16384 = 1 bit every 4 clk cycles
+  uint32_t cr = (16384 << 16) | (1 << 3) | 1;
+  tb->write(0x4, cr);
+
+  //=================================
+  //      Tick (1)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  tb->_nop();
+  core->wb_cyc_i = 1;
+
+  //=================================
+  //      Tick (2)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  tb->_nop();
+  // Single cycle glitch on the receive line
+  core->inj_frame_error = 1;
+
+  //=================================
+  //      Tick (3)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  core->inj_frame_error = 0;
+
+  //=================================
+  //      Tick (4-23)
+  
+  for(int i = 0; i < 20; i++) {
+    tb->tick();
+
+    //`````````````````````````````````
+    //      Checks 
+    
+    tb->check(COND_rx, (core->tb_ecap5_dwbuart->dut->rx_valid == 0));
+  }
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  tb->read(0x24);
+
+  //=================================
+  //      Tick (24)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  tb->check(COND_mem, (core->tb_ecap5_dwbuart->dut->mem_read_data_q == 1));
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  tb->_nop();
+  core->wb_cyc_i = 1;
+
+  //=================================
+  //      Tick (25)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  // Clear the counter
+  tb->write(0x24, 0);
+
+  //=================================
+  //      Tick (26)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  tb->_nop();
+  core->wb_cyc_i = 1;
+
+  //=================================
+  //      Tick (27)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  tb->read(0x24);
+
+  //=================================
+  //      Tick (28)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  tb->check(COND_mem, (core->tb_ecap5_dwbuart->dut->mem_read_data_q == 0));
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  tb->_nop();
+  core->wb_cyc_i = 1;
+
+  //=================================
+  //      Tick (29)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  tb->_nop();
+
+  //=================================
+  //      Tick (30)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Formal Checks 
+  
+  CHECK("tb_ecap5_dwbuart.false_start.01",
+      tb->conditions[COND_mem],
+      "Failed to integrate the memory", tb->err_cycles[COND_mem]);
+
+  CHECK("tb_ecap5_dwbuart.false_start.02",
+      tb->conditions[COND_rx],
+      "Failed to integrate the rx frontend", tb->err_cycles[COND_rx]);
+}
+
+/**
+ * @brief Measure the baud rate from a 0x55 synchronization character
+ *        and receive a frame with the measured baud rate.
+ */
+void tb_ecap5_dwbuart_autobaud(TB_Ecap5_dwbuart * tb) {
+  Vtb_ecap5_dwbuart * core = tb->core;
+  core->testcase = T_AUTOBAUD;
+
+  //=================================
+  //      Tick (0)
+  
+  tb->reset();
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  // Auto-baud with 8-bit data, no parity and 1 stop bit
+  tb->write(0x4, (1 << 5) | (1 << 3));
+
+  //=================================
+  //      Tick (1)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  tb->_nop();
+  core->wb_cyc_i = 1;
+
+  //=================================
+  //      Tick (2)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  tb->check(COND_reset, (core->tb_ecap5_dwbuart->dut->frontend_rst == 1));
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  tb->_nop();
+
+  //=================================
+  //      Tick (3-...)
+  
+  // Send the 0x55 character at 8 cycles per bit by forcing the line low
+  uint32_t bits = (1 << 9) | (0x55 << 1);
+  for(int i = 0; i < 10; i++) {
+    core->inj_frame_error = ((bits >> i) & 1) ? 0 : 1;
+    tb->n_tick(8);
+  }
+  core->inj_frame_error = 0;
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  // The measured baud rate is loaded and the auto-baud mode is left
+  // in the middle of the stop bit
+  tb->check(COND_registers, (core->tb_ecap5_dwbuart->dut->cr_abe_q == 0) &&
+                            (core->tb_ecap5_dwbuart->dut->cr_acc_incr_q == 8192) &&
+                            (core->tb_ecap5_dwbuart->dut->cr_acc_frac_q == 0));
+  tb->check(COND_reset,     (core->tb_ecap5_dwbuart->dut->frontend_rst == 0));
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  tb->read(0x28);
+
+  //=================================
+  //      Tick (...)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  tb->check(COND_mem, (core->tb_ecap5_dwbuart->dut->mem_read_data_q == 8));
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  tb->_nop();
+  core->wb_cyc_i = 1;
+
+  //=================================
+  //      Tick (...)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  tb->write(0xC, 0xA5);
+
+  //=================================
+  //      Tick (...)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  tb->_nop();
+  core->wb_cyc_i = 1;
+
+  //=================================
+  //      Tick (...)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  tb->_nop();
+
+  //=================================
+  //      Tick (...)
+  
+  // The frame is received through the loopback at the measured baud rate
+  uint32_t timeout = 1000;
+  while((core->tb_ecap5_dwbuart->dut->rx_valid == 0) && (timeout > 0)) {
+    tb->tick();
+    timeout -= 1;
+  }
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  tb->check(COND_rx, (timeout > 0) &&
+                     (tb->uart_rxdr() == 0xA5));
+
+  //`````````````````````````````````
+  //      Formal Checks 
+  
+  CHECK("tb_ecap5_dwbuart.autobaud.01",
+      tb->conditions[COND_reset],
+      "Failed to implement the frontend reset", tb->err_cycles[COND_reset]);
+
+  CHECK("tb_ecap5_dwbuart.autobaud.02",
+      tb->conditions[COND_mem],
+      "Failed to integrate the memory", tb->err_cycles[COND_mem]);
+
+  CHECK("tb_ecap5_dwbuart.autobaud.03",
+      tb->conditions[COND_rx],
+      "Failed to integrate the rx frontend", tb->err_cycles[COND_rx]);
+
+  CHECK("tb_ecap5_dwbuart.autobaud.04",
+      tb->conditions[COND_registers],
+      "Failed to implement the memory-mapped registers", tb->err_cycles[COND_registers]);
+}
+
+/**
+ * @brief Hold the transmission while CTS is deasserted and deassert RTS
+ *        when the receive fifo is about to be full.
+ */
+void tb_ecap5_dwbuart_flow_control(TB_Ecap5_dwbuart * tb) {
+  Vtb_ecap5_dwbuart * core = tb->core;
+  core->testcase = T_FLOW_CONTROL;
+
+  //=================================
+  //      Tick (0)
+  
+  tb->reset();
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  // CTS is deasserted
+  core->uart_cts_i = 1;
+  // (2**16)/4 = 16384 = 1 bit every 4 clk cycles, with RTS and CTS enabled
+  tb->write(0x4, (16384 << 16) | (1 << 7) | (1 << 6) | (1 << 3) | 1);
+
+  //=================================
+  //      Tick (1)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  tb->_nop();
+  core->wb_cyc_i = 1;
+
+  //=================================
+  //      Tick (2)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  tb->check(COND_registers, (tb->uart_cr() == ((16384 << 16) | (1 << 7) | (1 << 6) | (1 << 3) | 1)));
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  tb->write(0xC, 0xA5);
+
+  //=================================
+  //      Tick (3)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  tb->_nop();
+  core->wb_cyc_i = 1;
+
+  //=================================
+  //      Tick (4)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  tb->_nop();
+
+  //=================================
+  //      Tick (5-104)
+  
+  // The frame is held while CTS is deasserted
+  for(int i = 0; i < 100; i++) {
+    tb->tick();
+    tb->check(COND_tx, (core->uart_tx_o == 1) &&
+                       (core->tb_ecap5_dwbuart->dut->tx_transmit == 0));
+  }
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  tb->check(COND_registers, (((tb->uart_sr() >> 1) & 0x1) == 0));
+  tb->check(COND_rts, (core->uart_rts_o == 0));
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  core->uart_cts_i = 0;
+
+  //=================================
+  //      Tick (105-...)
+  
+  // The frame is sent once CTS is synchronized
+  tb->tick();
+  tb->check(COND_tx, (core->tb_ecap5_dwbuart->dut->tx_transmit == 0));
+  tb->tick();
+  tb->check(COND_tx, (core->tb_ecap5_dwbuart->dut->tx_transmit == 1));
+
+  // The frame is received through the loopback
+  uint32_t timeout = 1000;
+  while((core->tb_ecap5_dwbuart->dut->rx_valid == 0) && (timeout > 0)) {
+    tb->tick();
+    timeout -= 1;
+  }
+  tb->check(COND_rts, (core->uart_rts_o == 0));
+  tb->n_tick(2);
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  // RTS is deasserted when the receive fifo reaches RX_FIFO_DEPTH - 1 frames
+  tb->check(COND_rx,  (timeout > 0) &&
+                      (tb->uart_rxdr() == 0xA5));
+  tb->check(COND_rts, (core->tb_ecap5_dwbuart->dut->rx_fifo_count == (RX_FIFO_DEPTH - 1)) &&
+                      (core->uart_rts_o == 1));
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  tb->read(0x8);
+
+  //=================================
+  //      Tick (...)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  tb->_nop();
+  core->wb_cyc_i = 1;
+
+  //=================================
+  //      Tick (...)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  // RTS is asserted again once the fifo is read
+  tb->check(COND_rts, (core->uart_rts_o == 0));
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  tb->_nop();
+
+  //`````````````````````````````````
+  //      Formal Checks 
+  
+  CHECK("tb_ecap5_dwbuart.flow_control.01",
+      tb->conditions[COND_registers],
+      "Failed to implement the memory-mapped registers", tb->err_cycles[COND_registers]);
+
+  CHECK("tb_ecap5_dwbuart.flow_control.02",
+      tb->conditions[COND_tx],
+      "Failed to integrate the tx frontend", tb->err_cycles[COND_tx]);
+
+  CHECK("tb_ecap5_dwbuart.flow_control.03",
+      tb->conditions[COND_rx],
+      "Failed to integrate the rx frontend", tb->err_cycles[COND_rx]);
+
+  CHECK("tb_ecap5_dwbuart.flow_control.04",
+      tb->conditions[COND_rts],
+      "Failed to implement the RTS output", tb->err_cycles[COND_rts]);
+
+  core->uart_cts_i = 0;
+}
+
+/**
+ * @brief Change the baud rate while a frame is being sent with shadowed
+ *        UART_CR writes. The frame is completed and the next one is sent
+ *        with the new baud rate without resetting the frontends.
+ */
+void tb_ecap5_dwbuart_shadow_cr(TB_Ecap5_dwbuart * tb) {
+  Vtb_ecap5_dwbuart * core = tb->core;
+  core->testcase = T_SHADOW_CR;
+
+  // (2**16)/4 = 16384 = 1 bit every 4 clk cycles
+  uint32_t cr_fast = (16384 << 16) | (1 << 3) | 1;
+  // (2**16)/8 = 8192 = 1 bit every 8 clk cycles
+  uint32_t cr_slow = (8192 << 16) | (1 << 3) | 1;
+
+  //=================================
+  //      Tick (0)
+  
+  tb->reset();
+
+  //=================================
+  //      Tick (1-...)
+  
+  // Configure the baud rate, enable the shadowed mode and queue two frames
+  uint32_t addrs[] = {0x4, 0x2C, 0xC, 0xC};
+  uint32_t datas[] = {cr_fast, 1, 0xA5, 0x5A};
+  for(int i = 0; i < 4; i++) {
+    tb->write(addrs[i], datas[i]);
+    tb->tick();
+
+    tb->_nop();
+    core->wb_cyc_i = 1;
+    tb->tick();
+
+    tb->_nop();
+  }
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  tb->check(COND_registers, (core->tb_ecap5_dwbuart->dut->cr2_shd_q == 1) &&
+                            (tb->uart_cr() == cr_fast));
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  // The first frame is being sent
+  tb->write(0x4, cr_slow);
+
+  //=================================
+  //      Tick (...)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  tb->_nop();
+  core->wb_cyc_i = 1;
+
+  //=================================
+  //      Tick (...)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  // The new value is pending and the frontends are not reset
+  tb->check(COND_registers, (((tb->uart_sr() >> 8) & 0x1) == 1) &&
+                            (tb->uart_cr() == cr_fast));
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  tb->_nop();
+
+  //=================================
+  //      Tick (...)
+  
+  // The first frame is received through the loopback
+  uint32_t timeout = 1000;
+  while((core->tb_ecap5_dwbuart->dut->rx_valid == 0) && (timeout > 0)) {
+    tb->check(COND_reset, (core->tb_ecap5_dwbuart->dut->frontend_rst == 0));
+    tb->check(COND_registers, (tb->uart_cr() == cr_fast));
+    tb->tick();
+    timeout -= 1;
+  }
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  tb->check(COND_rx, (timeout > 0) &&
+                     ((core->tb_ecap5_dwbuart->dut->rx_frame & 0xFF) == 0xA5));
+
+  //=================================
+  //      Tick (...)
+  
+  // The new value is applied at the end of the first frame
+  timeout = 1000;
+  while((core->tb_ecap5_dwbuart->dut->cr_pending_q == 1) && (timeout > 0)) {
+    tb->check(COND_reset, (core->tb_ecap5_dwbuart->dut->frontend_rst == 0));
+    tb->tick();
+    timeout -= 1;
+  }
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  tb->check(COND_registers, (timeout > 0) &&
+                            (tb->uart_cr() == cr_slow));
+
+  //=================================
+  //      Tick (...)
+  
+  // The second frame is sent right away with the new baud rate
+  uint32_t gap = 0;
+  while((core->uart_tx_o == 1) && (gap < 1000)) {
+    tb->tick();
+    gap += 1;
+  }
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  tb->check(COND_tx, (gap < 4));
+
+  //=================================
+  //      Tick (...)
+  
+  timeout = 1000;
+  while((core->tb_ecap5_dwbuart->dut->rx_valid == 0) && (timeout > 0)) {
+    tb->check(COND_reset, (core->tb_ecap5_dwbuart->dut->frontend_rst == 0));
+    tb->tick();
+    timeout -= 1;
+  }
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  tb->check(COND_rx, (timeout > 0) &&
+                     ((core->tb_ecap5_dwbuart->dut->rx_frame & 0xFF) == 0x5A) &&
+                     (core->tb_ecap5_dwbuart->dut->rx_parity_err == 0));
+
+  //=================================
+  //      Tick (...)
+  
+  tb->n_tick(8);
+
+  //`````````````````````````````````
+  //      Formal Checks 
+  
+  CHECK("tb_ecap5_dwbuart.shadow_cr.01",
+      tb->conditions[COND_reset],
+      "Failed to implement the frontend reset", tb->err_cycles[COND_reset]);
+
+  CHECK("tb_ecap5_dwbuart.shadow_cr.02",
+      tb->conditions[COND_registers],
+      "Failed to implement the memory-mapped registers", tb->err_cycles[COND_registers]);
+
+  CHECK("tb_ecap5_dwbuart.shadow_cr.03",
+      tb->conditions[COND_tx],
+      "Failed to integrate the tx frontend", tb->err_cycles[COND_tx]);
+
+  CHECK("tb_ecap5_dwbuart.shadow_cr.04",
+      tb->conditions[COND_rx],
+      "Failed to integrate the rx frontend", tb->err_cycles[COND_rx]);
+}
+
+/**
+ * @brief Check the DMA requests against the fifo levels and their
+ *        acknowledge handshake.
+ */
+void tb_ecap5_dwbuart_dma(TB_Ecap5_dwbuart * tb) {
+  Vtb_ecap5_dwbuart * core = tb->core;
+  core->testcase = T_DMA;
+
+  //=================================
+  //      Tick (0)
+  
+  tb->reset();
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  tb->check(COND_dma, (core->dma_rx_req_o == 0) &&
+                      (core->dma_tx_req_o == 0));
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  core->dma_rx_ack_i = 0;
+  core->dma_tx_ack_i = 0;
+  // Enable both DMA requests
+  tb->write(0x2C, (1 << 2) | (1 << 1));
+
+  //=================================
+  //      Tick (1)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  tb->_nop();
+  core->wb_cyc_i = 1;
+
+  //=================================
+  //      Tick (2)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  // The transmit fifo can accept data while the receive fifo is empty
+  tb->check(COND_dma, (core->dma_rx_req_o == 0) &&
+                      (core->dma_tx_req_o == 1));
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  tb->_nop();
+
+  //=================================
+  //      Tick (3-...)
+  
+  tb->generate_frames(1);
+  tb->n_tick(3);
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  tb->check(COND_dma, (core->dma_rx_req_o == 1));
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  // Acknowledge without reading the data
+  core->dma_rx_ack_i = 1;
+
+  //=================================
+  //      Tick (...)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  tb->check(COND_dma, (core->dma_rx_req_o == 0));
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  core->dma_rx_ack_i = 0;
+
+  //=================================
+  //      Tick (...)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  // The request is asserted again as the data is still available
+  tb->check(COND_dma, (core->dma_rx_req_o == 1));
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  tb->read(0x8);
+
+  //=================================
+  //      Tick (...)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  tb->check(COND_mem, (core->tb_ecap5_dwbuart->dut->mem_read_data_q == 0xA5));
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  tb->_nop();
+  core->wb_cyc_i = 1;
+  core->dma_rx_ack_i = 1;
+
+  //=================================
+  //      Tick (...)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  tb->check(COND_dma, (core->dma_rx_req_o == 0));
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  tb->_nop();
+  core->dma_rx_ack_i = 0;
+
+  //=================================
+  //      Tick (...)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  // The receive fifo is empty
+  tb->check(COND_dma, (core->dma_rx_req_o == 0));
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  // Hold the transmission with CTS to fill the transmit fifo
+  core->uart_cts_i = 1;
+  tb->write(0x4, (16384 << 16) | (1 << 6) | (1 << 3) | 1);
+
+  //=================================
+  //      Tick (...)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  tb->_nop();
+  core->wb_cyc_i = 1;
+
+  //=================================
+  //      Tick (...)
+  
+  tb->tick();
+
+  for(int i = 0; i < TX_FIFO_DEPTH; i++) {
+    //`````````````````````````````````
+    //      Checks 
+    
+    tb->check(COND_dma, (core->dma_tx_req_o == 1));
+
+    //`````````````````````````````````
+    //      Set inputs
+    
+    tb->write(0xC, 0x5A);
+
+    //=================================
+    //      Tick (...)
+    
+    tb->tick();
+
+    //`````````````````````````````````
+    //      Set inputs
+    
+    tb->_nop();
+    core->wb_cyc_i = 1;
+    core->dma_tx_ack_i = 1;
+
+    //=================================
+    //      Tick (...)
+    
+    tb->tick();
+
+    //`````````````````````````````````
+    //      Checks 
+    
+    tb->check(COND_dma, (core->dma_tx_req_o == 0));
+
+    //`````````````````````````````````
+    //      Set inputs
+    
+    tb->_nop();
+    core->dma_tx_ack_i = 0;
+
+    //=================================
+    //      Tick (...)
+    
+    tb->tick();
+  }
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  // The transmit fifo is full
+  tb->check(COND_registers, ((tb->uart_sr() >> 5) & 0x1) == 1);
+  tb->check(COND_dma, (core->dma_tx_req_o == 0));
+
+  //`````````````````````````````````
+  //      Formal Checks 
+  
+  CHECK("tb_ecap5_dwbuart.dma.01",
+      tb->conditions[COND_mem],
+      "Failed to integrate the memory", tb->err_cycles[COND_mem]);
+
+  CHECK("tb_ecap5_dwbuart.dma.02",
+      tb->conditions[COND_registers],
+      "Failed to implement the memory-mapped registers", tb->err_cycles[COND_registers]);
+
+  CHECK("tb_ecap5_dwbuart.dma.03",
+      tb->conditions[COND_dma],
+      "Failed to implement the DMA requests", tb->err_cycles[COND_dma]);
+
+  core->uart_cts_i = 0;
+}
+
+/**
+ * @brief Fetch a single unaligned byte with the DMA master and check the
+ *        transfer complete flag.
+ */
+void tb_ecap5_dwbuart_dma_master(TB_Ecap5_dwbuart * tb) {
+  Vtb_ecap5_dwbuart * core = tb->core;
+  core->testcase = T_DMA_MASTER;
+
+  //=================================
+  //      Tick (0)
+  
+  tb->reset();
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  tb->check(COND_dma, (core->wbm_cyc_o == 0) &&
+                      (core->wbm_stb_o == 0));
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  tb->write(0x30, 0x102);
+
+  //=================================
+  //      Tick (1)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  tb->_nop();
+  core->wb_cyc_i = 1;
+  tb->write(0x34, 1);
+
+  //=================================
+  //      Tick (2)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  tb->_nop();
+
+  //=================================
+  //      Tick (3-...)
+  
+  // A single byte is fetched from memory
+  uint32_t num_accesses = 0;
+  bool sel_ok = true;
+  for(int i = 0; i < 10; i++) {
+    bool accepted = core->wbm_stb_o && !core->wbm_stall_i;
+    if(accepted) {
+      num_accesses += 1;
+      sel_ok &= (core->wbm_adr_o == 0x100) &&
+                (core->wbm_sel_o == 0x4) &&
+                (core->wbm_we_o == 0);
+    }
+
+    tb->tick();
+
+    core->wbm_ack_i = accepted;
+    core->wbm_dat_i = accepted ? 0x00A50000 : 0;
+  }
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  tb->check(COND_dma, (num_accesses == 1) &&
+                      sel_ok &&
+                      (core->wbm_cyc_o == 0));
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  tb->read(0x14);
+
+  //=================================
+  //      Tick (...)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  // The transfer complete flag is set
+  tb->check(COND_irq, ((core->tb_ecap5_dwbuart->dut->mem_read_data_q >> 6) & 1) == 1);
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  tb->_nop();
+  core->wb_cyc_i = 1;
+  tb->read(0x34);
+
+  //=================================
+  //      Tick (...)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  tb->check(COND_registers, (core->tb_ecap5_dwbuart->dut->mem_read_data_q == 0));
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  tb->_nop();
+
+  //`````````````````````````````````
+  //      Formal Checks 
+  
+  CHECK("tb_ecap5_dwbuart.dma_master.01",
+      tb->conditions[COND_dma],
+      "Failed to implement the DMA master interface", tb->err_cycles[COND_dma]);
+
+  CHECK("tb_ecap5_dwbuart.dma_master.02",
+      tb->conditions[COND_irq],
+      "Failed to implement the TXDC flag", tb->err_cycles[COND_irq]);
+
+  CHECK("tb_ecap5_dwbuart.dma_master.03",
+      tb->conditions[COND_registers],
+      "Failed to implement the UART_TXDLR register", tb->err_cycles[COND_registers]);
+}
+
+/**
+ * @brief Send frames from the transmit stream and receive them on the
+ *        receive stream, holding the second one to check the overrun.
+ */
+void tb_ecap5_dwbuart_stream(TB_Ecap5_dwbuart * tb) {
+  Vtb_ecap5_dwbuart * core = tb->core;
+  core->testcase = T_STREAM;
+
+  //=================================
+  //      Tick (0)
+  
+  tb->reset();
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  tb->check(COND_stream, (core->stream_tx_ready_o == 0) &&
+                         (core->stream_rx_valid_o == 0));
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  // (2**16)/4 = 16384 = 1 bit every 4 clk cycles
+  uint32_t cr = (16384 << 16) | (1 << 3) | 1;
+  tb->write(0x4, cr);
+
+  //=================================
+  //      Tick (1-2)
+  
+  tb->tick();
+  tb->_nop();
+  core->wb_cyc_i = 1;
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  // Enable both streams
+  tb->write(0x2C, (1 << 4) | (1 << 3));
+
+  //=================================
+  //      Tick (3-5)
+  
+  tb->tick();
+  tb->_nop();
+  core->wb_cyc_i = 1;
+  tb->tick();
+  tb->_nop();
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  tb->check(COND_stream, (core->stream_tx_ready_o == 1) &&
+                         (core->stream_rx_valid_o == 0));
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  // Writes to UART_TXDR and UART_TXPDR are ignored
+  tb->write(0xC, 0x33);
+
+  //=================================
+  //      Tick (6-7)
+  
+  tb->tick();
+  tb->_nop();
+  core->wb_cyc_i = 1;
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  tb->write(0x18, 0x44332211);
+
+  //=================================
+  //      Tick (8-...)
+  
+  tb->tick();
+  tb->_nop();
+  core->wb_cyc_i = 1;
+  for(int i = 0; i < 20; i++) {
+    tb->tick();
+
+    //`````````````````````````````````
+    //      Checks 
+    
+    tb->check(COND_tx, (core->tb_ecap5_dwbuart->dut->tx_transmit == 0) &&
+                       (core->uart_tx_o == 1));
+  }
+  tb->check(COND_tx, ((tb->uart_sr() >> 1) & 1) == 1);
+  tb->_nop();
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  core->stream_tx_valid_i = 1;
+  core->stream_tx_data_i = 0xA5;
+
+  //=================================
+  //      Tick (...)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  core->stream_tx_valid_i = 0;
+
+  //=================================
+  //      Tick (...)
+  
+  uint32_t timeout = 100;
+  while(!core->stream_rx_valid_o && timeout > 0) {
+    tb->tick();
+    timeout--;
+  }
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  // The frame is not queued in the receive fifo
+  tb->check(COND_stream, (core->stream_rx_valid_o == 1) &&
+                         (core->stream_rx_data_o == 0xA5) &&
+                         (core->stream_rx_err_o == 0));
+  tb->check(COND_registers, ((tb->uart_sr() & 0x1) == 0));
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  core->stream_tx_valid_i = 1;
+  core->stream_tx_data_i = 0x5A;
+
+  //=================================
+  //      Tick (...)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  core->stream_tx_valid_i = 0;
+
+  //=================================
+  //      Tick (...)
+  
+  // The second frame is received while the first one is held
+  tb->n_tick(100);
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  tb->check(COND_stream, (core->stream_rx_valid_o == 1) &&
+                         (core->stream_rx_data_o == 0xA5));
+  tb->check(COND_registers, (core->tb_ecap5_dwbuart->dut->sr_rxoe_q == 1));
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  core->stream_rx_ready_i = 1;
+
+  //=================================
+  //      Tick (...)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  tb->check(COND_stream, (core->stream_rx_valid_o == 0));
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  tb->_nop();
+
+  //`````````````````````````````````
+  //      Formal Checks 
+  
+  CHECK("tb_ecap5_dwbuart.stream.01",
+      tb->conditions[COND_stream],
+      "Failed to implement the streaming interface", tb->err_cycles[COND_stream]);
+
+  CHECK("tb_ecap5_dwbuart.stream.02",
+      tb->conditions[COND_registers],
+      "Failed to implement the memory-mapped registers", tb->err_cycles[COND_registers]);
+
+  CHECK("tb_ecap5_dwbuart.stream.03",
+      tb->conditions[COND_tx],
+      "Failed to integrate the tx frontend", tb->err_cycles[COND_tx]);
+}
+
+void tb_ecap5_dwbuart_break(TB_Ecap5_dwbuart * tb) {
+  Vtb_ecap5_dwbuart * core = tb->core;
+  core->testcase = T_BREAK;
+
+  //=================================
+  //      Tick (0)
+  
+  tb->reset();
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  // (2**16)/4 = 16384 = 1 bit every 4 clk cycles
+  uint32_t cr = (16384 << 16) | (1 << 3) | 1;
+  tb->write(0x4, cr);
+
+  //=================================
+  //      Tick (1-2)
+  
+  tb->tick();
+  tb->_nop();
+  core->wb_cyc_i = 1;
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  // Enable the break interrupt
+  tb->write(0x10, (1 << 8));
+
+  //=================================
+  //      Tick (3-4)
+  
+  tb->tick();
+  tb->_nop();
+  core->wb_cyc_i = 1;
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  // Send a break of 21 bit times
+  tb->write(0x2C, (20 << 8) | (1 << 5));
+
+  //=================================
+  //      Tick (5-6)
+  
+  tb->tick();
+  tb->_nop();
+  core->wb_cyc_i = 1;
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  tb->_nop();
+
+  //=================================
+  //      Tick (7-...)
+  
+  uint32_t num_low = 0;
+  for(int i = 0; i < 150; i++) {
+    tb->tick();
+    num_low += (core->uart_tx_o == 0);
+  }
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  // The send break request is cleared once the break is sent
+  tb->check(COND_tx, (num_low == 21 * 4) &&
+                     (core->tb_ecap5_dwbuart->dut->cr2_sbk_q == 0));
+  // The break is received as a single null frame
+  tb->check(COND_rx, (core->tb_ecap5_dwbuart->dut->rx_fifo_count == 1) &&
+                     (tb->uart_rxdr() == 0));
+  tb->check(COND_registers, (((tb->uart_sr() >> 9) & 0x1) == 1));
+  tb->check(COND_irq, (core->irq_o == 1));
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  tb->read(0x0);
+
+  //=================================
+  //      Tick (...)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  // The break status is cleared by reading UART_SR
+  tb->check(COND_registers, (((core->tb_ecap5_dwbuart->dut->mem_read_data_q >> 9) & 0x1) == 1) &&
+                            (((tb->uart_sr() >> 9) & 0x1) == 0));
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  tb->_nop();
+  core->wb_cyc_i = 1;
+
+  //=================================
+  //      Tick (...)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  // Acknowledge the break interrupt
+  tb->write(0x14, (1 << 8));
+
+  //=================================
+  //      Tick (...)
+  
+  tb->tick();
+  tb->_nop();
+  core->wb_cyc_i = 1;
+  tb->tick();
+  tb->_nop();
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  tb->check(COND_irq, (core->irq_o == 0));
+
+  // The break is neither counted as a transmitted frame in UART_TXFCR
+  // nor as a received frame in UART_RXFCR, UART_PECR and UART_FECR
+  uint32_t addr[] = {0x48, 0x4C, 0x50, 0x54};
+  for(int i = 0; i < 4; i++) {
+    //`````````````````````````````````
+    //      Set inputs
+    
+    tb->read(addr[i]);
+
+    //=================================
+    //      Tick (...)
+    
+    tb->tick();
+
+    //`````````````````````````````````
+    //      Checks 
+    
+    tb->check(COND_registers, (core->tb_ecap5_dwbuart->dut->mem_read_data_q == 0));
+
+    //`````````````````````````````````
+    //      Set inputs
+    
+    tb->_nop();
+    core->wb_cyc_i = 1;
+
+    //=================================
+    //      Tick (...)
+    
+    tb->tick();
+    tb->_nop();
+  }
+
+  //`````````````````````````````````
+  //      Formal Checks 
+  
+  CHECK("tb_ecap5_dwbuart.break.01",
+      tb->conditions[COND_tx],
+      "Failed to send the break", tb->err_cycles[COND_tx]);
+
+  CHECK("tb_ecap5_dwbuart.break.02",
+      tb->conditions[COND_rx],
+      "Failed to receive the break", tb->err_cycles[COND_rx]);
+
+  CHECK("tb_ecap5_dwbuart.break.03",
+      tb->conditions[COND_registers],
+      "Failed to implement the memory-mapped registers", tb->err_cycles[COND_registers]);
+
+  CHECK("tb_ecap5_dwbuart.break.04",
+      tb->conditions[COND_irq],
+      "Failed to implement the break interrupt", tb->err_cycles[COND_irq]);
+}
+
+void tb_ecap5_dwbuart_mpe(TB_Ecap5_dwbuart * tb) {
+  Vtb_ecap5_dwbuart * core = tb->core;
+  core->testcase = T_MPE;
+
+  //=================================
+  //      Tick (0)
+  
+  tb->reset();
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  // (2**16)/4 = 16384 = 1 bit every 4 clk cycles
+  uint32_t cr = (16384 << 16) | (1 << 3);
+  tb->write(0x4, cr);
+
+  //=================================
+  //      Tick (1-2)
+  
+  tb->tick();
+  tb->_nop();
+  core->wb_cyc_i = 1;
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  // Enable the address match interrupt
+  tb->write(0x10, (1 << 9));
+
+  //=================================
+  //      Tick (3-4)
+  
+  tb->tick();
+  tb->_nop();
+  core->wb_cyc_i = 1;
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  // Enable the multiprocessor mode with the node address 0x12
+  tb->write(0x2C, (0xFF << 24) | (0x12 << 16) | (1 << 6));
+
+  //=================================
+  //      Tick (5-6)
+  
+  tb->tick();
+  tb->_nop();
+  core->wb_cyc_i = 1;
+  tb->tick();
+
+  //=================================
+  //      Tick (7-...)
+  
+  // Data written to UART_TXDR along with its address mark in bit 8
+  uint32_t data[] = {0x033, 0x155, 0x112, 0x0A5};
+  // Expected number of queued frames and address match after each frame
+  uint32_t expected_count[] = {0, 0, 0, 1};
+  uint32_t expected_adm[] = {0, 0, 1, 1};
+  for(int i = 0; i < 4; i++) {
+    //`````````````````````````````````
+    //      Set inputs
+    
+    tb->write(0xC, data[i]);
+
+    //=================================
+    //      Tick (...)
+    
+    tb->tick();
+    tb->_nop();
+    core->wb_cyc_i = 1;
+    tb->tick();
+    tb->_nop();
+
+    // 1 start bit, 8 data bits, 1 address mark, 1 stop bit
+    tb->n_tick((1 + 8 + 1 + 1) * 4 + 8);
+
+    //`````````````````````````````````
+    //      Checks 
+    
+    tb->check(COND_rx, (core->tb_ecap5_dwbuart->dut->rx_fifo_count == expected_count[i]));
+    tb->check(COND_registers, (((tb->uart_sr() >> 10) & 0x1) == expected_adm[i]));
+    tb->check(COND_irq, (core->irq_o == expected_adm[i]));
+  }
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  // Only the data frame following the matching address is queued
+  tb->check(COND_rx, (tb->uart_rxdr() == 0xA5));
+
+  //`````````````````````````````````
+  //      Formal Checks 
+  
+  CHECK("tb_ecap5_dwbuart.mpe.01",
+      tb->conditions[COND_rx],
+      "Failed to filter the received frames", tb->err_cycles[COND_rx]);
+
+  CHECK("tb_ecap5_dwbuart.mpe.02",
+      tb->conditions[COND_registers],
+      "Failed to implement the memory-mapped registers", tb->err_cycles[COND_registers]);
+
+  CHECK("tb_ecap5_dwbuart.mpe.03",
+      tb->conditions[COND_irq],
+      "Failed to implement the address match interrupt", tb->err_cycles[COND_irq]);
+}
+
+void tb_ecap5_dwbuart_de(TB_Ecap5_dwbuart * tb) {
+  Vtb_ecap5_dwbuart * core = tb->core;
+  core->testcase = T_DE;
+
+  //=================================
+  //      Tick (0)
+  
+  tb->reset();
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  // (2**16)/4 = 16384 = 1 bit every 4 clk cycles
+  uint32_t cr = (16384 << 16) | (1 << 3);
+  tb->write(0x4, cr);
+
+  //=================================
+  //      Tick (1-2)
+  
+  tb->tick();
+  tb->_nop();
+  core->wb_cyc_i = 1;
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  // Assert the driver enable 2 bit times before the frame and deassert it
+  // 3 bit times after the frame
+  tb->write(0x40, (3 << 16) | (2 << 8) | 1);
+
+  //=================================
+  //      Tick (3-4)
+  
+  tb->tick();
+  tb->_nop();
+  core->wb_cyc_i = 1;
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  tb->check(COND_de, (core->uart_de_o == 0));
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  tb->write(0xC, 0xA5);
+
+  //=================================
+  //      Tick (5-6)
+  
+  tb->tick();
+  tb->_nop();
+  core->wb_cyc_i = 1;
+  tb->tick();
+  tb->_nop();
+
+  //=================================
+  //      Tick (7-...)
+  
+  int first_de = -1, last_de = -1, first_low = -1;
+  uint32_t num_de = 0;
+  for(int t = 0; t < 100; t++) {
+    tb->tick();
+
+    if(core->uart_de_o) {
+      if(first_de < 0) {
+        first_de = t;
+      }
+      last_de = t;
+      num_de += 1;
+    }
+    if((first_low < 0) && (core->uart_tx_o == 0)) {
+      first_low = t;
+    }
+  }
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  // 1 start bit, 8 data bits, 1 stop bit
+  int last_frame_tick = first_low + (1 + 8 + 1) * 4 - 1;
+  tb->check(COND_de, (first_de >= 0) && (first_low >= 0) &&
+                     (num_de == (uint32_t)(last_de - first_de + 1)));
+  tb->check(COND_de, (first_low - first_de) == (2 * 4));
+  tb->check(COND_de, (last_de - last_frame_tick) == (3 * 4));
+
+  //`````````````````````````````````
+  //      Formal Checks 
+  
+  CHECK("tb_ecap5_dwbuart.de.01",
+      tb->conditions[COND_de],
+      "Failed to implement the driver enable signal", tb->err_cycles[COND_de]);
+}
+
+void tb_ecap5_dwbuart_loopback(TB_Ecap5_dwbuart * tb) {
+  Vtb_ecap5_dwbuart * core = tb->core;
+  core->testcase = T_LOOPBACK;
+
+  //=================================
+  //      Tick (0)
+  
+  tb->reset();
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  // (2**16)/4 = 16384 = 1 bit every 4 clk cycles
+  uint32_t cr = (16384 << 16) | (1 << 3);
+  tb->write(0x4, cr);
+
+  //=================================
+  //      Tick (1-2)
+  
+  tb->tick();
+  tb->_nop();
+  core->wb_cyc_i = 1;
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  // Enable the loopback mode
+  tb->write(0x44, 1);
+
+  //=================================
+  //      Tick (3-4)
+  
+  tb->tick();
+  tb->_nop();
+  core->wb_cyc_i = 1;
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  tb->write(0xC, 0xA5);
+
+  //=================================
+  //      Tick (5-...)
+  
+  tb->tick();
+  tb->_nop();
+  core->wb_cyc_i = 1;
+  tb->tick();
+  tb->_nop();
+
+  // The external line is stuck low
+  core->inj_frame_error = 1;
+
+  uint32_t num_low = 0;
+  for(int t = 0; t < (1 + 8 + 1) * 4 + 20; t++) {
+    tb->tick();
+    num_low += (core->uart_tx_o == 0);
+  }
+
+  core->inj_frame_error = 0;
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  // The pin is held idle and the external line is ignored
+  tb->check(COND_tx, (num_low == 0));
+  tb->check(COND_rx, (core->tb_ecap5_dwbuart->dut->rx_fifo_count == 1) &&
+                     (tb->uart_rxdr() == 0xA5) &&
+                     (((tb->uart_sr() >> 3) & 0x1) == 0));
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  // Pop the received frame
+  tb->read(0x8);
+
+  //=================================
+  //      Tick (...)
+  
+  tb->tick();
+  tb->_nop();
+  core->wb_cyc_i = 1;
+  tb->tick();
+  tb->_nop();
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  // Switch to the line monitor mode
+  tb->write(0x44, 2);
+
+  //=================================
+  //      Tick (...)
+  
+  tb->tick();
+  tb->_nop();
+  core->wb_cyc_i = 1;
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  // The frame written in line monitor mode is held in the transmit fifo
+  tb->write(0xC, 0x5A);
+
+  //=================================
+  //      Tick (...)
+  
+  tb->tick();
+  tb->_nop();
+  core->wb_cyc_i = 1;
+  tb->tick();
+  tb->_nop();
+
+  // The external line follows inj_parity_error while inj_frame_error is
+  // asserted. A frame is sent on it followed by an idle line.
+  core->inj_frame_error = 1;
+  uint32_t line = (1 << 9) | (0xC3 << 1);
+  uint8_t prev_level = 1;
+  bool echoed = true;
+  for(int t = 0; t < (1 + 8 + 1) * 4 + 20; t++) {
+    uint8_t level = (t < 10 * 4) ? ((line >> (t / 4)) & 1) : 1;
+    core->inj_parity_error = level;
+    tb->tick();
+    // The line is echoed on the pin with the delay of its synchronizer
+    echoed = echoed && (core->uart_tx_o == prev_level);
+    prev_level = level;
+  }
+
+  // The pin echoes the idle line once the injection is released
+  core->inj_frame_error = 0;
+  core->inj_parity_error = 0;
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  tb->check(COND_tx, echoed && ((tb->uart_sr() & 0x2) == 0));
+  tb->check(COND_rx, (core->tb_ecap5_dwbuart->dut->rx_fifo_count == 1) &&
+                     (tb->uart_rxdr() == 0xC3) &&
+                     (((tb->uart_sr() >> 3) & 0x1) == 0));
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  // Pop the received frame
+  tb->read(0x8);
+
+  //=================================
+  //      Tick (...)
+  
+  tb->tick();
+  tb->_nop();
+  core->wb_cyc_i = 1;
+  tb->tick();
+  tb->_nop();
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  // Leave the line monitor mode
+  tb->write(0x44, 0);
+
+  //=================================
+  //      Tick (...)
+  
+  tb->tick();
+  tb->_nop();
+  core->wb_cyc_i = 1;
+  tb->tick();
+  tb->_nop();
+
+  tb->n_tick((1 + 8 + 1) * 4 + 20);
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  // The held frame is transmitted and received through the bench loop
+  tb->check(COND_tx, (tb->uart_sr() & 0x2));
+  tb->check(COND_rx, (core->tb_ecap5_dwbuart->dut->rx_fifo_count == 1) &&
+                     (tb->uart_rxdr() == 0x5A));
+
+  //`````````````````````````````````
+  //      Formal Checks 
+  
+  CHECK("tb_ecap5_dwbuart.loopback.01",
+      tb->conditions[COND_tx],
+      "Failed to implement the serial output", tb->err_cycles[COND_tx]);
+
+  CHECK("tb_ecap5_dwbuart.loopback.02",
+      tb->conditions[COND_rx],
+      "Failed to receive the looped back frames", tb->err_cycles[COND_rx]);
+}
+
+/**
+ * @brief Count the traffic and the reception errors and read them as a
+ *        single sample starting with UART_TXFCR.
+ */
+void tb_ecap5_dwbuart_statistics(TB_Ecap5_dwbuart * tb) {
+  Vtb_ecap5_dwbuart * core = tb->core;
+  core->testcase = T_STATISTICS;
+
+  //=================================
+  //      Tick (0)
+  
+  tb->reset();
+
+  // Three frames with one overrun, then a parity error overrunning the
+  // still full receive fifo
+  tb->generate_rxoe();
+  tb->n_tick(8);
+  tb->generate_pe();
+  tb->n_tick(8);
+
+  // Counters from UART_TXFCR to UART_FSTCR, read twice. The first
+  // read of UART_TXFCR restarts the counters.
+  uint32_t addr[] = {0x48, 0x4C, 0x50, 0x54, 0x58, 0x5C, 0x48, 0x4C};
+  uint32_t expected[] = {4, 4, 1, 0, 2, 0, 0, 0};
+  for(int i = 0; i < 8; i++) {
+    //`````````````````````````````````
+    //      Set inputs
+    
+    tb->read(addr[i]);
+
+    //=================================
+    //      Tick (...)
+    
+    tb->tick();
+
+    //`````````````````````````````````
+    //      Checks 
+    
+    tb->check(COND_registers, (core->tb_ecap5_dwbuart->dut->mem_read_data_q == expected[i]));
+
+    //`````````````````````````````````
+    //      Set inputs
+    
+    tb->_nop();
+    core->wb_cyc_i = 1;
+
+    //=================================
+    //      Tick (...)
+    
+    tb->tick();
+    tb->_nop();
+  }
+
+  //`````````````````````````````````
+  //      Formal Checks 
+  
+  CHECK("tb_ecap5_dwbuart.statistics.01",
+      tb->conditions[COND_registers],
+      "Failed to implement the statistics counters", tb->err_cycles[COND_registers]);
+}
+
+/**
+ * @brief Timestamp a received frame and a transmitted frame and read both
+ *        timestamps back.
+ */
+void tb_ecap5_dwbuart_timestamp(TB_Ecap5_dwbuart * tb) {
+  Vtb_ecap5_dwbuart * core = tb->core;
+  core->testcase = T_TIMESTAMP;
+
+  //=================================
+  //      Tick (0)
+  
+  tb->reset();
+
+  //=================================
+  //      Tick (1-...)
+  
+  tb->generate_read();
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  // The frame is pushed with the current counter value
+  tb->check(COND_rx, (core->tb_ecap5_dwbuart->dut->rx_valid == 1));
+  uint32_t rx_ts = core->tb_ecap5_dwbuart->dut->ts_cnt_q;
+
+  tb->n_tick(8);
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  tb->write(0xC, 0x5A);
+
+  //=================================
+  //      Tick (...)
+  
+  tb->tick();
+  tb->_nop();
+  core->wb_cyc_i = 1;
+  tb->tick();
+  tb->_nop();
+
+  int tx_ts = -1;
+  for(int t = 0; t < 20; t++) {
+    tb->tick();
+    if((tx_ts < 0) && (core->uart_tx_o == 0)) {
+      tx_ts = core->tb_ecap5_dwbuart->dut->ts_cnt_q;
+    }
+  }
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  tb->check(COND_tx, (tx_ts >= 0));
+
+  // The receive timestamp is the one of the oldest frame
+  uint32_t addr[] = {0x60, 0x64};
+  uint32_t expected[] = {rx_ts, (uint32_t)tx_ts};
+  for(int i = 0; i < 2; i++) {
+    //`````````````````````````````````
+    //      Set inputs
+    
+    tb->read(addr[i]);
+
+    //=================================
+    //      Tick (...)
+    
+    tb->tick();
+
+    //`````````````````````````````````
+    //      Checks 
+    
+    tb->check(COND_registers, (core->tb_ecap5_dwbuart->dut->mem_read_data_q == expected[i]));
+
+    //`````````````````````````````````
+    //      Set inputs
+    
+    tb->_nop();
+    core->wb_cyc_i = 1;
+
+    //=================================
+    //      Tick (...)
+    
+    tb->tick();
+    tb->_nop();
+  }
+
+  //=================================
+  //      Tick (...)
+  
+  // The transmitted frame is received through the external loop
+  tb->n_tick(40);
+
+  // Both frames are popped by UART_RXPDR along with their timestamps
+  uint32_t pop_addr[] = {0x1C, 0x60};
+  uint32_t pop_expected[] = {(2 << 24) | (0x5A << 8) | 0xA5, 0};
+  for(int i = 0; i < 2; i++) {
+    //`````````````````````````````````
+    //      Set inputs
+    
+    tb->read(pop_addr[i]);
+
+    //=================================
+    //      Tick (...)
+    
+    tb->tick();
+
+    //`````````````````````````````````
+    //      Checks 
+    
+    tb->check(COND_registers, (core->tb_ecap5_dwbuart->dut->mem_read_data_q == pop_expected[i]));
+
+    //`````````````````````````````````
+    //      Set inputs
+    
+    tb->_nop();
+    core->wb_cyc_i = 1;
+
+    //=================================
+    //      Tick (...)
+    
+    tb->tick();
+    tb->_nop();
+  }
+
+  //`````````````````````````````````
+  //      Formal Checks 
+  
+  CHECK("tb_ecap5_dwbuart.timestamp.01",
+      tb->conditions[COND_rx],
+      "Failed to receive the frame", tb->err_cycles[COND_rx]);
+
+  CHECK("tb_ecap5_dwbuart.timestamp.02",
+      tb->conditions[COND_tx],
+      "Failed to transmit the frame", tb->err_cycles[COND_tx]);
+
+  CHECK("tb_ecap5_dwbuart.timestamp.03",
+      tb->conditions[COND_registers],
+      "Failed to implement the timestamp registers", tb->err_cycles[COND_registers]);
+}
+
+/**
+ * @brief Receive a frame matching a disabled match character and then an
+ *        enabled one, raising the character match interrupt.
+ */
+void tb_ecap5_dwbuart_char_match(TB_Ecap5_dwbuart * tb) {
+  Vtb_ecap5_dwbuart * core = tb->core;
+  core->testcase = T_CHAR_MATCH;
+
+  //=================================
+  //      Tick (0)
+  
+  tb->reset();
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  // Enable the character match interrupt
+  tb->write(0x10, (1 << 10));
+
+  //=================================
+  //      Tick (1-2)
+  
+  tb->tick();
+  tb->_nop();
+  core->wb_cyc_i = 1;
+  tb->tick();
+  tb->_nop();
+
+  // The frames sent by generate_read hold A5h, which is only enabled
+  // the second time
+  uint32_t cmr[] = {(1 << 16) | (0xA5 << 8) | 0x0A,
+                    (1 << 17) | (1 << 16) | (0xA5 << 8) | 0x0A};
+  for(int i = 0; i < 2; i++) {
+    //`````````````````````````````````
+    //      Set inputs
+    
+    tb->write(0x6C, cmr[i]);
+
+    //=================================
+    //      Tick (...)
+    
+    tb->tick();
+    tb->_nop();
+    core->wb_cyc_i = 1;
+    tb->tick();
+    tb->_nop();
+
+    tb->generate_read();
+    tb->n_tick(3);
+
+    //`````````````````````````````````
+    //      Checks 
+    
+    tb->check(COND_registers, (((tb->uart_sr() >> 11) & 0x1) == (uint32_t)i));
+    tb->check(COND_irq, (core->irq_o == (uint32_t)i));
+  }
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  // Acknowledge the interrupt
+  tb->write(0x14, (1 << 10));
+
+  //=================================
+  //      Tick (...)
+  
+  tb->tick();
+  tb->_nop();
+  core->wb_cyc_i = 1;
+  tb->tick();
+  tb->_nop();
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  tb->check(COND_irq, (core->irq_o == 0));
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  // The flag is cleared by reading UART_SR
+  tb->read(0x0);
+
+  //=================================
+  //      Tick (...)
+  
+  tb->tick();
+  tb->_nop();
+  core->wb_cyc_i = 1;
+  tb->tick();
+  tb->_nop();
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  tb->check(COND_registers, (((tb->uart_sr() >> 11) & 0x1) == 0));
+
+  //`````````````````````````````````
+  //      Formal Checks 
+  
+  CHECK("tb_ecap5_dwbuart.char_match.01",
+      tb->conditions[COND_registers],
+      "Failed to implement the character match flag", tb->err_cycles[COND_registers]);
+
+  CHECK("tb_ecap5_dwbuart.char_match.02",
+      tb->conditions[COND_irq],
+      "Failed to implement the character match interrupt", tb->err_cycles[COND_irq]);
+}
+
+/**
+ * @brief Send a packet followed by its CRC-16/CCITT-FALSE computed by the
+ *        transmit CRC and check that the receive CRC residue is null.
+ */
+void tb_ecap5_dwbuart_crc(TB_Ecap5_dwbuart * tb) {
+  Vtb_ecap5_dwbuart * core = tb->core;
+  core->testcase = T_CRC;
+
+  //=================================
+  //      Tick (0)
+  
+  tb->reset();
+
+  // (2**16)/4 = 16384 = 1 bit every 4 clk cycles
+  // Polynomial 1021h, init FFFFh, both engines enabled, then cleared
+  uint32_t config[][2] = {
+    {0x4,  (16384 << 16) | (1 << 3)},
+    {0x74, 0x1021},
+    {0x78, 0xFFFF},
+    {0x70, 0x3},
+    {0x7C, 0},
+    {0x80, 0}
+  };
+  for(int i = 0; i < 6; i++) {
+    //`````````````````````````````````
+    //      Set inputs
+    
+    tb->write(config[i][0], config[i][1]);
+
+    //=================================
+    //      Tick (...)
+    
+    tb->tick();
+    tb->_nop();
+    core->wb_cyc_i = 1;
+    tb->tick();
+    tb->_nop();
+  }
+
+  uint8_t packet[5] = {0x31, 0x32, 0x33};
+  uint32_t expected = 0xFFFF;
+  for(int i = 0; i < 3; i++) {
+    expected ^= packet[i] << 8;
+    for(int j = 0; j < 8; j++) {
+      expected = (expected & 0x8000) ? ((expected << 1) ^ 0x1021) : (expected << 1);
+    }
+    expected &= 0xFFFF;
+  }
+  // The CRC is appended msb first
+  packet[3] = expected >> 8;
+  packet[4] = expected & 0xFF;
+
+  for(int i = 0; i < 5; i++) {
+    //`````````````````````````````````
+    //      Set inputs
+    
+    tb->write(0xC, packet[i]);
+
+    //=================================
+    //      Tick (...)
+    
+    tb->tick();
+    tb->_nop();
+    core->wb_cyc_i = 1;
+    tb->tick();
+    tb->_nop();
+
+    // 1 start bit, 8 data bits, 1 stop bit
+    tb->n_tick((1 + 8 + 1) * 4 + 8);
+
+    if(i == 2) {
+      //`````````````````````````````````
+      //      Set inputs
+      
+      tb->read(0x7C);
+
+      //=================================
+      //      Tick (...)
+      
+      tb->tick();
+
+      //`````````````````````````````````
+      //      Checks 
+      
+      tb->check(COND_tx, (core->tb_ecap5_dwbuart->dut->mem_read_data_q == expected));
+
+      //`````````````````````````````````
+      //      Set inputs
+      
+      tb->_nop();
+      core->wb_cyc_i = 1;
+
+      //=================================
+      //      Tick (...)
+      
+      tb->tick();
+      tb->_nop();
+    }
+  }
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  tb->read(0x80);
+
+  //=================================
+  //      Tick (...)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  // The received packet, overrun frames included, is valid
+  tb->check(COND_rx, (core->tb_ecap5_dwbuart->dut->mem_read_data_q == 0));
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  tb->_nop();
+  core->wb_cyc_i = 1;
+
+  //=================================
+  //      Tick (...)
+  
+  tb->tick();
+  tb->_nop();
+
+  //`````````````````````````````````
+  //      Formal Checks 
+  
+  CHECK("tb_ecap5_dwbuart.crc.01",
+      tb->conditions[COND_tx],
+      "Failed to implement the transmit CRC", tb->err_cycles[COND_tx]);
+
+  CHECK("tb_ecap5_dwbuart.crc.02",
+      tb->conditions[COND_rx],
+      "Failed to implement the receive CRC", tb->err_cycles[COND_rx]);
+}
+
+int main(int argc, char ** argv, char ** env) {
+  srand(time(NULL));
+  Verilated::traceEverOn(true);
+
+  bool verbose = parse_verbose(argc, argv);
+
+  TB_Ecap5_dwbuart * tb = new TB_Ecap5_dwbuart;
+  tb->open_trace("waves/ecap5_dwbuart.vcd");
+  tb->open_testdata("testdata/ecap5_dwbuart.csv");
+  tb->set_debug_log(verbose);
+  tb->init_conditions(__CondIdEnd);
+
+  /************************************************************/
+
+  tb_ecap5_dwbuart_idle(tb);
+
+  tb_ecap5_dwbuart_write_cr(tb);
+  tb_ecap5_dwbuart_write_txdr(tb);
+  tb_ecap5_dwbuart_read_rxdr(tb);
+
+  tb_ecap5_dwbuart_rxoe(tb);
+  tb_ecap5_dwbuart_fe(tb);
+  tb_ecap5_dwbuart_pe(tb);
+
+  tb_ecap5_dwbuart_error_retention(tb);
+  tb_ecap5_dwbuart_race_sr(tb);
+  tb_ecap5_dwbuart_race_txdr(tb);
+  tb_ecap5_dwbuart_race_rxdr(tb);
+
+  tb_ecap5_dwbuart_rx_fifo(tb);
+  tb_ecap5_dwbuart_tx_fifo(tb);
+  tb_ecap5_dwbuart_txpdr(tb);
+  tb_ecap5_dwbuart_rxpdr(tb);
+
+  tb_ecap5_dwbuart_irq(tb);
+  tb_ecap5_dwbuart_rx_timeout(tb);
+  tb_ecap5_dwbuart_false_start(tb);
+  tb_ecap5_dwbuart_autobaud(tb);
+  tb_ecap5_dwbuart_flow_control(tb);
+  tb_ecap5_dwbuart_shadow_cr(tb);
+  tb_ecap5_dwbuart_dma(tb);
+  tb_ecap5_dwbuart_dma_master(tb);
+  tb_ecap5_dwbuart_stream(tb);
+  tb_ecap5_dwbuart_break(tb);
+  tb_ecap5_dwbuart_mpe(tb);
+  tb_ecap5_dwbuart_de(tb);
+  tb_ecap5_dwbuart_loopback(tb);
+  tb_ecap5_dwbuart_statistics(tb);
+  tb_ecap5_dwbuart_timestamp(tb);
+  tb_ecap5_dwbuart_char_match(tb);
+  tb_ecap5_dwbuart_crc(tb);
 
   /************************************************************/
 
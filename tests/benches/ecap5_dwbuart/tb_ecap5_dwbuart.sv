@@ -27,6 +27,8 @@ module tb_ecap5_dwbuart
   input   logic         clk_i,
   input   logic         rst_i,
 
+  output  logic         irq_o,
+
   //=================================
   //    Memory interface
 
@@ -44,17 +46,62 @@ module tb_ecap5_dwbuart
   //    Serial interface
   
   output logic uart_tx_o,
+  output logic uart_de_o,
   input logic inj_frame_error,
-  input logic inj_parity_error
+  input logic inj_parity_error,
+
+  //=================================
+  //    Flow control interface
+
+  input  logic uart_cts_i,
+  output logic uart_rts_o,
+
+  //=================================
+  //    DMA interface
+
+  output logic dma_rx_req_o,
+  input  logic dma_rx_ack_i,
+  output logic dma_tx_req_o,
+  input  logic dma_tx_ack_i,
+
+  //=================================
+  //    DMA master interface
+
+  output logic[31:0]  wbm_adr_o,
+  output logic[31:0]  wbm_dat_o,
+  input  logic[31:0]  wbm_dat_i,
+  output logic        wbm_we_o,
+  output logic[3:0]   wbm_sel_o,
+  output logic        wbm_stb_o,
+  input  logic        wbm_ack_i,
+  output logic        wbm_cyc_o,
+  input  logic        wbm_stall_i,
+
+  //=================================
+  //    Streaming interface
+
+  input  logic        stream_tx_valid_i,
+  input  logic[7:0]   stream_tx_data_i,
+  output logic        stream_tx_ready_o,
+
+  output logic        stream_rx_valid_o,
+  output logic[7:0]   stream_rx_data_o,
+  output logic[2:0]   stream_rx_err_o,
+  input  logic        stream_rx_ready_i
 );
 
 logic uart_tx;
 logic uart_rx;
 
-ecap5_dwbuart dut (
+ecap5_dwbuart #(
+  .RX_FIFO_DEPTH (2),
+  .TX_FIFO_DEPTH (2)
+) dut (
   .clk_i           (clk_i),
   .rst_i           (rst_i),
 
+  .irq_o           (irq_o),
+
   .wb_adr_i   (wb_adr_i),
   .wb_dat_o   (wb_dat_o),
   .wb_dat_i   (wb_dat_i),
@@ -65,8 +112,43 @@ ecap5_dwbuart dut (
   .wb_cyc_i   (wb_cyc_i),
   .wb_stall_o (wb_stall_o),
 
+  .reg_addr_i       ('0),
+  .reg_read_i       (0),
+  .reg_read_data_o  (),
+  .reg_write_i      (0),
+  .reg_write_data_i ('0),
+  .reg_sel_i        ('0),
+
   .uart_rx_i       (uart_rx),
-  .uart_tx_o       (uart_tx)
+  .uart_tx_o       (uart_tx),
+  .uart_de_o       (uart_de_o),
+
+  .uart_cts_i      (uart_cts_i),
+  .uart_rts_o      (uart_rts_o),
+
+  .dma_rx_req_o    (dma_rx_req_o),
+  .dma_rx_ack_i    (dma_rx_ack_i),
+  .dma_tx_req_o    (dma_tx_req_o),
+  .dma_tx_ack_i    (dma_tx_ack_i),
+
+  .wbm_adr_o       (wbm_adr_o),
+  .wbm_dat_o       (wbm_dat_o),
+  .wbm_dat_i       (wbm_dat_i),
+  .wbm_we_o        (wbm_we_o),
+  .wbm_sel_o       (wbm_sel_o),
+  .wbm_stb_o       (wbm_stb_o),
+  .wbm_ack_i       (wbm_ack_i),
+  .wbm_cyc_o       (wbm_cyc_o),
+  .wbm_stall_i     (wbm_stall_i),
+
+  .stream_tx_valid_i (stream_tx_valid_i),
+  .stream_tx_data_i  (stream_tx_data_i),
+  .stream_tx_ready_o (stream_tx_ready_o),
+
+  .stream_rx_valid_o (stream_rx_valid_o),
+  .stream_rx_data_o  (stream_rx_data_o),
+  .stream_rx_err_o   (stream_rx_err_o),
+  .stream_rx_ready_i (stream_rx_ready_i)
 );
 
 assign uart_tx_o = uart_tx;
@@ -86,19 +168,38 @@ public -module "ecap5_dwbuart" -var "mem_write_data"
 
 public -module "ecap5_dwbuart" -var "rx_frame"
 public -module "ecap5_dwbuart" -var "rx_parity"
+public -module "ecap5_dwbuart" -var "rx_parity_err"
 public -module "ecap5_dwbuart" -var "rx_valid"
 
-public -module "ecap5_dwbuart" -var "tx_transmit_q"
+public -module "ecap5_dwbuart" -var "tx_transmit"
 public -module "ecap5_dwbuart" -var "tx_done"
+public -module "ecap5_dwbuart" -var "rx_fifo_count"
 
+public -module "ecap5_dwbuart" -var "cr_pending_q"
+public -module "ecap5_dwbuart" -var "cr2_shd_q"
+public -module "ecap5_dwbuart" -var "cr2_sbk_q"
 public -module "ecap5_dwbuart" -var "cr_acc_incr_q"
+public -module "ecap5_dwbuart" -var "cr_acc_frac_q"
+public -module "ecap5_dwbuart" -var "cr_rtse_q"
+public -module "ecap5_dwbuart" -var "cr_ctse_q"
+public -module "ecap5_dwbuart" -var "cr_abe_q"
+public -module "ecap5_dwbuart" -var "cr_ovs_q"
 public -module "ecap5_dwbuart" -var "cr_ds_q"
 public -module "ecap5_dwbuart" -var "cr_s_q"
 public -module "ecap5_dwbuart" -var "cr_p_q"
+public -module "ecap5_dwbuart" -var "sr_cmf_q"
+public -module "ecap5_dwbuart" -var "sr_adm_q"
+public -module "ecap5_dwbuart" -var "sr_brk_q"
+public -module "ecap5_dwbuart" -var "sr_nf_q"
+public -module "ecap5_dwbuart" -var "sr_rto_q"
 public -module "ecap5_dwbuart" -var "sr_pe_q"
 public -module "ecap5_dwbuart" -var "sr_fe_q"
 public -module "ecap5_dwbuart" -var "sr_rxoe_q"
-public -module "ecap5_dwbuart" -var "sr_txe_q"
-public -module "ecap5_dwbuart" -var "sr_rxne_q"
-public -module "ecap5_dwbuart" -var "rxdr_rxd_q"
-public -module "ecap5_dwbuart" -var "txdr_txd_q"
+public -module "ecap5_dwbuart" -var "sr_txf"
+public -module "ecap5_dwbuart" -var "sr_txe"
+public -module "ecap5_dwbuart" -var "sr_tc"
+public -module "ecap5_dwbuart" -var "sr_rxne"
+public -module "ecap5_dwbuart" -var "rx_fifo_data"
+public -module "ecap5_dwbuart" -var "isr_pe_q"
+public -module "ecap5_dwbuart" -var "tx_data"
+public -module "ecap5_dwbuart" -var "ts_cnt_q"
@@ -0,0 +1,363 @@
+/*           __        _
+ *  ________/ /  ___ _(_)__  ___
+ * / __/ __/ _ \/ _ `/ / _ \/ -_)
+ * \__/\__/_//_/\_,_/_/_//_/\__/
+ * 
+ * Copyright (C) Clément Chaine
+ * This file is part of ECAP5-DWBUART <https://github.com/ecap5/ECAP5-DWBUART>
+ *
+ * ECAP5-DWBUART is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ECAP5-DWBUART is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ECAP5-DWBUART.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <verilated.h>
+#include <verilated_vcd_c.h>
+#include <svdpi.h>
+
+#include "Vtb_ecap5_dwbuart_array.h"
+#include "Vtb_ecap5_dwbuart_array_tb_ecap5_dwbuart_array.h"
+#include "Vtb_ecap5_dwbuart_array_ecap5_dwbuart_array.h"
+#include "testbench.h"
+
+// Base address of the register bank of a channel
+#define CHANNEL_BASE(n) (((n) + 1) * 0x100)
+
+enum CondId {
+  COND_mem,
+  COND_registers,
+  COND_irq,
+  __CondIdEnd
+};
+
+enum TestcaseId {
+  T_IDLE      = 1,
+  T_REGISTERS = 2,
+  T_IRQ       = 3,
+  T_DMA       = 4
+};
+
+class TB_Ecap5_dwbuart_array : public Testbench<Vtb_ecap5_dwbuart_array> {
+public:
+  void reset() {
+    this->_nop();
+
+    this->core->rst_i = 1;
+    for(int i = 0; i < 5; i++) {
+      this->tick();
+    }
+    this->core->rst_i = 0;
+
+    Testbench<Vtb_ecap5_dwbuart_array>::reset();
+  }
+  
+  void _nop() {
+    this->core->wb_adr_i = 0;
+    this->core->wb_dat_i = 0;
+    this->core->wb_we_i = 0;
+    this->core->wb_sel_i = 0;
+    this->core->wb_stb_i = 0;
+    this->core->wb_cyc_i = 0;
+  }
+
+  void read(uint32_t addr) {
+    this->core->wb_adr_i = addr;
+    this->core->wb_dat_i = 0;
+    this->core->wb_we_i = 0;
+    this->core->wb_sel_i = 0xF;
+    this->core->wb_stb_i = 1;
+    this->core->wb_cyc_i = 1;
+  }
+
+  void write(uint32_t addr, uint32_t data) {
+    this->core->wb_adr_i = addr;
+    this->core->wb_dat_i = data;
+    this->core->wb_we_i = 1;
+    this->core->wb_sel_i = 0xF;
+    this->core->wb_stb_i = 1;
+    this->core->wb_cyc_i = 1;
+  }
+
+  /**
+   * Performs a complete write request.
+   */
+  void write_reg(uint32_t addr, uint32_t data) {
+    this->write(addr, data);
+    this->tick();
+
+    this->_nop();
+    this->core->wb_cyc_i = 1;
+    this->tick();
+
+    this->_nop();
+  }
+
+  /**
+   * Performs a complete read request and returns the read data.
+   */
+  uint32_t read_reg(uint32_t addr) {
+    this->read(addr);
+    this->tick();
+
+    uint32_t data = this->core->tb_ecap5_dwbuart_array->dut->mem_read_data;
+
+    this->_nop();
+    this->core->wb_cyc_i = 1;
+    this->tick();
+
+    this->_nop();
+    return data;
+  }
+};
+
+void tb_ecap5_dwbuart_array_idle(TB_Ecap5_dwbuart_array * tb) {
+  Vtb_ecap5_dwbuart_array * core = tb->core;
+  core->testcase = T_IDLE;
+
+  //=================================
+  //      Tick (0)
+  
+  tb->reset();
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  tb->check(COND_irq,  (core->irq_o == 0));
+  tb->check(COND_registers, (core->tb_ecap5_dwbuart_array->dut->chier_q == 0));
+
+  //=================================
+  //      Tick (1-...)
+  
+  tb->n_tick(5);
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  // The transmit lines are idle
+  tb->check(COND_irq,  (core->irq_o == 0) &&
+                       (core->uart_tx_o == 0x3));
+
+  //`````````````````````````````````
+  //      Formal Checks 
+  
+  CHECK("tb_ecap5_dwbuart_array.idle.01",
+      tb->conditions[COND_irq],
+      "Failed to implement the irq_o signal", tb->err_cycles[COND_irq]);
+
+  CHECK("tb_ecap5_dwbuart_array.idle.02",
+      tb->conditions[COND_registers],
+      "Failed to implement the shared registers", tb->err_cycles[COND_registers]);
+}
+
+void tb_ecap5_dwbuart_array_registers(TB_Ecap5_dwbuart_array * tb) {
+  Vtb_ecap5_dwbuart_array * core = tb->core;
+  core->testcase = T_REGISTERS;
+
+  //=================================
+  //      Tick (0)
+  
+  tb->reset();
+
+  //=================================
+  //      Tick (1-...)
+  
+  // Write UART_RTOR of the second channel
+  tb->write_reg(CHANNEL_BASE(1) + 0x20, 0x5A);
+  uint32_t rtor1 = tb->read_reg(CHANNEL_BASE(1) + 0x20);
+  uint32_t rtor0 = tb->read_reg(CHANNEL_BASE(0) + 0x20);
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  // The channels have their own register bank
+  tb->check(COND_mem, (rtor1 == 0x5A) &&
+                      (rtor0 == 0));
+
+  //=================================
+  //      Tick (...)
+  
+  tb->write_reg(0x4, 0x3);
+  uint32_t chier = tb->read_reg(0x4);
+  uint32_t chisr = tb->read_reg(0x0);
+  // Accesses outside of the register banks have no effect
+  tb->write_reg(CHANNEL_BASE(2) + 0x20, 0x5A);
+  uint32_t unmapped = tb->read_reg(CHANNEL_BASE(2) + 0x20);
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  tb->check(COND_mem, (chier == 0x3) &&
+                      (chisr == 0) &&
+                      (unmapped == 0));
+
+  //`````````````````````````````````
+  //      Formal Checks 
+  
+  CHECK("tb_ecap5_dwbuart_array.registers.01",
+      tb->conditions[COND_mem],
+      "Failed to implement the register banks", tb->err_cycles[COND_mem]);
+}
+
+void tb_ecap5_dwbuart_array_irq(TB_Ecap5_dwbuart_array * tb) {
+  Vtb_ecap5_dwbuart_array * core = tb->core;
+  core->testcase = T_IRQ;
+
+  //=================================
+  //      Tick (0)
+  
+  tb->reset();
+
+  //=================================
+  //      Tick (1-...)
+  
+  // Enable the TXE interrupt of the second channel, which is pending as its
+  // transmit fifo is empty
+  tb->write_reg(CHANNEL_BASE(1) + 0x10, (1 << 1));
+  tb->n_tick(3);
+  uint32_t chisr = tb->read_reg(0x0);
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  // The interrupt is summarized but not raised while the channel is masked
+  tb->check(COND_mem, (chisr == 0x2));
+  tb->check(COND_irq, (core->irq_o == 0));
+
+  //=================================
+  //      Tick (...)
+  
+  tb->write_reg(0x4, 0x1);
+  tb->n_tick(2);
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  tb->check(COND_irq, (core->irq_o == 0));
+
+  //=================================
+  //      Tick (...)
+  
+  tb->write_reg(0x4, 0x2);
+  tb->n_tick(2);
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  tb->check(COND_irq, (core->irq_o == 1));
+
+  //`````````````````````````````````
+  //      Formal Checks 
+  
+  CHECK("tb_ecap5_dwbuart_array.irq.01",
+      tb->conditions[COND_mem],
+      "Failed to implement the interrupt summary register", tb->err_cycles[COND_mem]);
+
+  CHECK("tb_ecap5_dwbuart_array.irq.02",
+      tb->conditions[COND_irq],
+      "Failed to implement the irq_o signal", tb->err_cycles[COND_irq]);
+}
+
+/**
+ * @brief Access the DMA and streaming registers of a channel, which are not
+ *        available in the array. They are expected to read as zero and to
+ *        ignore writes.
+ */
+void tb_ecap5_dwbuart_array_dma(TB_Ecap5_dwbuart_array * tb) {
+  Vtb_ecap5_dwbuart_array * core = tb->core;
+  core->testcase = T_DMA;
+
+  //=================================
+  //      Tick (0)
+  
+  tb->reset();
+
+  //=================================
+  //      Tick (1-...)
+  
+  // Program both DMA channels
+  tb->write_reg(CHANNEL_BASE(1) + 0x30, 0x1000);
+  tb->write_reg(CHANNEL_BASE(1) + 0x34, 4);
+  tb->write_reg(CHANNEL_BASE(1) + 0x38, 0x2000);
+  tb->write_reg(CHANNEL_BASE(1) + 0x3C, 4);
+  uint32_t txdar = tb->read_reg(CHANNEL_BASE(1) + 0x30);
+  uint32_t txdlr = tb->read_reg(CHANNEL_BASE(1) + 0x34);
+  uint32_t rxdar = tb->read_reg(CHANNEL_BASE(1) + 0x38);
+  uint32_t rxdlr = tb->read_reg(CHANNEL_BASE(1) + 0x3C);
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  tb->check(COND_mem, (txdar == 0) &&
+                      (txdlr == 0) &&
+                      (rxdar == 0) &&
+                      (rxdlr == 0));
+
+  //=================================
+  //      Tick (...)
+  
+  // Enable the streams and the DMA requests along with the shadowed updates
+  tb->write_reg(CHANNEL_BASE(1) + 0x2C, 0x1F);
+  uint32_t cr2 = tb->read_reg(CHANNEL_BASE(1) + 0x2C);
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  // Only the shadowed updates are enabled
+  tb->check(COND_registers, (cr2 == 0x1));
+
+  //`````````````````````````````````
+  //      Formal Checks 
+  
+  CHECK("tb_ecap5_dwbuart_array.dma.01",
+      tb->conditions[COND_mem],
+      "Failed to remove the DMA registers", tb->err_cycles[COND_mem]);
+
+  CHECK("tb_ecap5_dwbuart_array.dma.02",
+      tb->conditions[COND_registers],
+      "Failed to remove the streaming and DMA control fields", tb->err_cycles[COND_registers]);
+}
+
+int main(int argc, char ** argv, char ** env) {
+  srand(time(NULL));
+  Verilated::traceEverOn(true);
+
+  bool verbose = parse_verbose(argc, argv);
+
+  TB_Ecap5_dwbuart_array * tb = new TB_Ecap5_dwbuart_array;
+  tb->open_trace("waves/ecap5_dwbuart_array.vcd");
+  tb->open_testdata("testdata/ecap5_dwbuart_array.csv");
+  tb->set_debug_log(verbose);
+  tb->init_conditions(__CondIdEnd);
+
+  /************************************************************/
+
+  tb_ecap5_dwbuart_array_idle(tb);
+
+  tb_ecap5_dwbuart_array_registers(tb);
+  tb_ecap5_dwbuart_array_irq(tb);
+  tb_ecap5_dwbuart_array_dma(tb);
+
+  /************************************************************/
+
+  printf("[ECAP5_DWBUART_ARRAY]: ");
+  if(tb->success) {
+    printf("Done\n");
+  } else {
+    printf("Failed\n");
+  }
+
+  delete tb;
+  exit(EXIT_SUCCESS);
+}
@@ -0,0 +1,423 @@
+/*           __        _
+ *  ________/ /  ___ _(_)__  ___
+ * / __/ __/ _ \/ _ `/ / _ \/ -_)
+ * \__/\__/_//_/\_,_/_/_//_/\__/
+ * 
+ * Copyright (C) Clément Chaine
+ * This file is part of ECAP5-DWBUART <https://github.com/ecap5/ECAP5-DWBUART>
+ *
+ * ECAP5-DWBUART is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ECAP5-DWBUART is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ECAP5-DWBUART.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <verilated.h>
+#include <verilated_vcd_c.h>
+#include <svdpi.h>
+
+#include "Vtb_fifo.h"
+#include "Vtb_fifo_fifo.h"
+#include "Vtb_fifo_tb_fifo.h"
+#include "testbench.h"
+
+// Depth of the instantiated fifo
+#define DEPTH 4
+
+enum CondId {
+  COND_data,
+  COND_status,
+  __CondIdEnd
+};
+
+enum TestcaseId {
+  T_IDLE         = 1,
+  T_WRITE_READ   = 2,
+  T_FULL         = 3,
+  T_SIMULTANEOUS = 4
+};
+
+class TB_Fifo : public Testbench<Vtb_fifo> {
+public:
+  void reset() {
+    this->_nop();
+
+    this->core->rst_i = 1;
+    for(int i = 0; i < 5; i++) {
+      this->tick();
+    }
+    this->core->rst_i = 0;
+
+    Testbench<Vtb_fifo>::reset();
+  }
+  
+  void _nop() {
+    core->write_i = 0;
+    core->data_i = 0;
+    core->read_i = 0;
+  }
+
+  void push(uint8_t data) {
+    core->write_i = 1;
+    core->data_i = data;
+    this->tick();
+    this->_nop();
+  }
+
+  void pop() {
+    core->read_i = 1;
+    this->tick();
+    this->_nop();
+  }
+};
+
+void tb_fifo_idle(TB_Fifo * tb) {
+  Vtb_fifo * core = tb->core;
+  core->testcase = T_IDLE;
+
+  //=================================
+  //      Tick (0)
+  
+  tb->reset();
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  tb->check(COND_data,   (core->data_o == 0));
+  tb->check(COND_status, (core->empty_o == 1) &&
+                         (core->full_o == 0) &&
+                         (core->count_o == 0));
+
+  //=================================
+  //      Tick (1)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  tb->check(COND_data,   (core->data_o == 0));
+  tb->check(COND_status, (core->empty_o == 1) &&
+                         (core->full_o == 0) &&
+                         (core->count_o == 0));
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  // Reading an empty fifo shall have no effect
+  core->read_i = 1;
+
+  //=================================
+  //      Tick (2)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  tb->check(COND_data,   (core->data_o == 0));
+  tb->check(COND_status, (core->empty_o == 1) &&
+                         (core->full_o == 0) &&
+                         (core->count_o == 0) &&
+                         (core->tb_fifo->dut->rd_ptr_q == 0));
+
+  //`````````````````````````````````
+  //      Formal Checks 
+  
+  CHECK("tb_fifo.idle.01",
+      tb->conditions[COND_data],
+      "Failed to implement the data output", tb->err_cycles[COND_data]);
+
+  CHECK("tb_fifo.idle.02",
+      tb->conditions[COND_status],
+      "Failed to implement the status signals", tb->err_cycles[COND_status]);
+}
+
+void tb_fifo_write_read(TB_Fifo * tb) {
+  Vtb_fifo * core = tb->core;
+  core->testcase = T_WRITE_READ;
+
+  //=================================
+  //      Tick (0)
+  
+  tb->reset();
+
+  //=================================
+  //      Tick (1)
+  
+  tb->push(0x5A);
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  tb->check(COND_data,   (core->data_o == 0x5A));
+  tb->check(COND_status, (core->empty_o == 0) &&
+                         (core->full_o == 0) &&
+                         (core->count_o == 1));
+
+  //=================================
+  //      Tick (2)
+  
+  tb->push(0xA5);
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  // The head of the fifo is not modified by a write
+  tb->check(COND_data,   (core->data_o == 0x5A));
+  tb->check(COND_status, (core->empty_o == 0) &&
+                         (core->full_o == 0) &&
+                         (core->count_o == 2));
+
+  //=================================
+  //      Tick (3)
+  
+  tb->pop();
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  tb->check(COND_data,   (core->data_o == 0xA5));
+  tb->check(COND_status, (core->empty_o == 0) &&
+                         (core->full_o == 0) &&
+                         (core->count_o == 1));
+
+  //=================================
+  //      Tick (4)
+  
+  tb->pop();
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  tb->check(COND_data,   (core->data_o == 0));
+  tb->check(COND_status, (core->empty_o == 1) &&
+                         (core->full_o == 0) &&
+                         (core->count_o == 0));
+
+  //`````````````````````````````````
+  //      Formal Checks 
+  
+  CHECK("tb_fifo.write_read.01",
+      tb->conditions[COND_data],
+      "Failed to implement the data output", tb->err_cycles[COND_data]);
+
+  CHECK("tb_fifo.write_read.02",
+      tb->conditions[COND_status],
+      "Failed to implement the status signals", tb->err_cycles[COND_status]);
+}
+
+void tb_fifo_full(TB_Fifo * tb) {
+  Vtb_fifo * core = tb->core;
+  core->testcase = T_FULL;
+
+  //=================================
+  //      Tick (0)
+  
+  tb->reset();
+
+  //=================================
+  //      Tick (1-4)
+  
+  for(int i = 0; i < DEPTH; i++) {
+    tb->push(0x10 + i);
+
+    //`````````````````````````````````
+    //      Checks 
+    
+    tb->check(COND_data,   (core->data_o == 0x10));
+    tb->check(COND_status, (core->empty_o == 0) &&
+                           (core->full_o == (i == (DEPTH - 1))) &&
+                           (core->count_o == (i + 1)));
+  }
+
+  //=================================
+  //      Tick (5)
+  
+  // Writing a full fifo shall have no effect
+  tb->push(0xFF);
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  tb->check(COND_status, (core->full_o == 1) &&
+                         (core->count_o == DEPTH));
+
+  //=================================
+  //      Tick (6-9)
+  
+  // The pointers shall wrap around
+  for(int i = 0; i < DEPTH; i++) {
+    //`````````````````````````````````
+    //      Checks 
+    
+    tb->check(COND_data, (core->data_o == (0x10 + i)));
+
+    tb->pop();
+  }
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  tb->check(COND_status, (core->empty_o == 1) &&
+                         (core->full_o == 0) &&
+                         (core->count_o == 0) &&
+                         (core->tb_fifo->dut->rd_ptr_q == 0) &&
+                         (core->tb_fifo->dut->wr_ptr_q == 0));
+
+  //`````````````````````````````````
+  //      Formal Checks 
+  
+  CHECK("tb_fifo.full.01",
+      tb->conditions[COND_data],
+      "Failed to implement the data output", tb->err_cycles[COND_data]);
+
+  CHECK("tb_fifo.full.02",
+      tb->conditions[COND_status],
+      "Failed to implement the status signals", tb->err_cycles[COND_status]);
+}
+
+void tb_fifo_simultaneous(TB_Fifo * tb) {
+  Vtb_fifo * core = tb->core;
+  core->testcase = T_SIMULTANEOUS;
+
+  //=================================
+  //      Tick (0)
+  
+  tb->reset();
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  // Reading and writing an empty fifo only performs the write
+  core->write_i = 1;
+  core->data_i = 0x10;
+  core->read_i = 1;
+
+  //=================================
+  //      Tick (1)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  tb->check(COND_data,   (core->data_o == 0x10));
+  tb->check(COND_status, (core->empty_o == 0) &&
+                         (core->count_o == 1));
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  tb->_nop();
+
+  //=================================
+  //      Tick (2-4)
+  
+  for(int i = 1; i < DEPTH; i++) {
+    tb->push(0x10 + i);
+  }
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  tb->check(COND_status, (core->full_o == 1));
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  // Reading and writing a full fifo performs both
+  core->write_i = 1;
+  core->data_i = 0x20;
+  core->read_i = 1;
+
+  //=================================
+  //      Tick (5)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  tb->check(COND_data,   (core->data_o == 0x11));
+  tb->check(COND_status, (core->full_o == 1) &&
+                         (core->count_o == DEPTH));
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  tb->_nop();
+
+  //=================================
+  //      Tick (6-9)
+  
+  uint8_t expected[] = {0x11, 0x12, 0x13, 0x20};
+  for(int i = 0; i < DEPTH; i++) {
+    //`````````````````````````````````
+    //      Checks 
+    
+    tb->check(COND_data, (core->data_o == expected[i]));
+
+    tb->pop();
+  }
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  tb->check(COND_status, (core->empty_o == 1));
+
+  //`````````````````````````````````
+  //      Formal Checks 
+  
+  CHECK("tb_fifo.simultaneous.01",
+      tb->conditions[COND_data],
+      "Failed to implement the data output", tb->err_cycles[COND_data]);
+
+  CHECK("tb_fifo.simultaneous.02",
+      tb->conditions[COND_status],
+      "Failed to implement the status signals", tb->err_cycles[COND_status]);
+}
+
+int main(int argc, char ** argv, char ** env) {
+  srand(time(NULL));
+  Verilated::traceEverOn(true);
+
+  bool verbose = parse_verbose(argc, argv);
+
+  TB_Fifo * tb = new TB_Fifo;
+  tb->open_trace("waves/fifo.vcd");
+  tb->open_testdata("testdata/fifo.csv");
+  tb->set_debug_log(verbose);
+  tb->init_conditions(__CondIdEnd);
+
+  /************************************************************/
+
+  tb_fifo_idle(tb);
+
+  tb_fifo_write_read(tb);
+  tb_fifo_full(tb);
+  tb_fifo_simultaneous(tb);
+
+  /************************************************************/
+
+  printf("[FIFO]: ");
+  if(tb->success) {
+    printf("Done\n");
+  } else {
+    printf("Failed\n");
+  }
+
+  delete tb;
+  exit(EXIT_SUCCESS);
+}
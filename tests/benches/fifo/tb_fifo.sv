@@ -0,0 +1,64 @@
+/*           __        _
+ *  ________/ /  ___ _(_)__  ___
+ * / __/ __/ _ \/ _ `/ / _ \/ -_)
+ * \__/\__/_//_/\_,_/_/_//_/\__/
+ * 
+ * Copyright (C) Clément Chaine
+ * This file is part of ECAP5-DWBUART <https://github.com/ecap5/ECAP5-DWBUART>
+ *
+ * ECAP5-DWBUART is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ECAP5-DWBUART is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ECAP5-DWBUART.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+module tb_fifo
+(
+  input   int          testcase,
+
+  input   logic         clk_i,
+  input   logic         rst_i,
+
+  input   logic         write_i,
+  input   logic[7:0]    data_i,
+
+  input   logic         read_i,
+  output  logic[7:0]    data_o,
+
+  output  logic         empty_o,
+  output  logic         full_o,
+  output  logic[2:0]    count_o
+);
+
+fifo #(
+  .DATA_WIDTH (8),
+  .DEPTH      (4)
+) dut (
+  .clk_i    (clk_i),
+  .rst_i    (rst_i),
+
+  .write_i  (write_i),
+  .data_i   (data_i),
+
+  .read_i   (read_i),
+  .data_o   (data_o),
+
+  .empty_o  (empty_o),
+  .full_o   (full_o),
+  .count_o  (count_o)
+);
+
+endmodule // tb_fifo
+
+`verilator_config
+
+public -module "fifo" -var "wr_ptr_q"
+public -module "fifo" -var "rd_ptr_q"
@@ -23,6 +23,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <time.h>
+#include <math.h>
 #include <verilated.h>
 #include <verilated_vcd_c.h>
 #include <svdpi.h>
@@ -37,6 +38,7 @@ enum CondId {
   COND_frame,
   COND_valid,
   COND_errors,
+  COND_timeout,
   __CondIdEnd
 };
 
@@ -57,7 +59,13 @@ enum TestcaseId {
   T_BAUDRATE    = 14,
   T_PARITY_EVEN = 15,
   T_PARITY_ODD  = 16,
-  T_FRAMING     = 17
+  T_FRAMING     = 17,
+  T_TIMEOUT     = 18,
+  T_OVERSAMPLING = 19,
+  T_FALSE_START = 20,
+  T_BAUDRATE_HIGH = 21,
+  T_BREAK       = 22,
+  T_MPE         = 23
 };
 
 enum StateId {
@@ -81,6 +89,8 @@ class TB_Rx_frontend : public Testbench<Vtb_rx_frontend> {
 public:
   uint32_t accumulator_increment;
   uint32_t accumulator;
+  // Clock frequency used to compute the accumulator increment
+  uint32_t clk_freq = 24000000;
 
   void reset() {
     this->_nop();
@@ -97,9 +107,15 @@ public:
   void _nop() {
     core->uart_rx_i = 1;
     core->cr_acc_incr_i = 0;
+    core->cr_acc_frac_i = 0;
     core->cr_ds_i = 0;
     core->cr_p_i = 0;
     core->cr_s_i = 0;
+    core->cr_ovs_i = 0;
+    core->cr_mpe_i = 0;
+    core->mpe_addr_i = 0;
+    core->mpe_mask_i = 0;
+    core->rtor_rto_i = 0;
   }
   
   void set_injected_baudrate(uint32_t acc_increment) {
@@ -109,25 +125,146 @@ public:
 
   uint32_t get_cycles_before_next_accumulator_overflow() {
     uint32_t cycles = 0;
-    while(this->accumulator < (1 << 16)) {
+    while(this->accumulator < (1 << 24)) {
       cycles += 1;
       this->accumulator += this->accumulator_increment;
     }
 
-    this->accumulator = this->accumulator & ((1 << 16) - 1);
+    this->accumulator = this->accumulator & ((1 << 24) - 1);
 
     return cycles;
   }
 
+  /**
+   * Sends a 8N1 frame at 16 clock cycles per bit, inverting the line
+   * for a single cycle at the given cycle of the given bit.
+   * Returns true when the frame was received as valid.
+   */
+  bool inject_glitched_frame(uint32_t data, uint32_t glitch_bit, uint32_t glitch_cycle,
+                             uint32_t * frame, uint8_t * noise) {
+    // (2**16)/16 = 4096 = 1 bit every 16 clk cycles
+    this->core->cr_acc_incr_i = 4096;
+    this->core->cr_ds_i = 1;
+    this->core->cr_p_i = 0;
+    this->core->cr_s_i = 0;
+
+    // start bit, 8 data bits, stop bit
+    uint32_t bits = (1 << 9) | ((data & 0xFF) << 1);
+
+    bool valid = false;
+    for(uint32_t i = 0; i < 11; i++) {
+      for(uint32_t j = 0; j < 16; j++) {
+        // The line is idle after the stop bit
+        uint8_t level = (i < 10) ? ((bits >> i) & 1) : 1;
+        if((i == glitch_bit) && (j == glitch_cycle)) {
+          level ^= 1;
+        }
+        this->core->uart_rx_i = level;
+        this->tick();
+
+        if(this->core->output_valid_o) {
+          valid = true;
+          *frame = this->core->frame_o;
+          *noise = this->core->noise_err_o;
+        }
+      }
+    }
+    return valid;
+  }
+
+  /**
+   * Sends a 8O2 frame with its bit edges placed at the ideal bit period of
+   * the given baudrate, independently of the accumulator increment. The
+   * edges are shifted by the given fraction of a clock cycle.
+   * Returns true when the frame was received as valid.
+   */
+  bool inject_nominal_frame(uint32_t baudrate, uint32_t data, double phase,
+                            uint32_t * frame, bool * errors) {
+    uint32_t acc_increment = round(((double)baudrate * (1 << 24)) / this->clk_freq);
+    this->core->cr_acc_incr_i = acc_increment >> 8;
+    this->core->cr_acc_frac_i = acc_increment & 0xFF;
+    this->core->cr_ds_i = 1;
+    this->core->cr_p_i = 1;
+    this->core->cr_s_i = 1;
+
+    this->core->uart_rx_i = 1;
+    this->tick();
+
+    uint8_t parity = 1;
+    for(int j = 0; j < 8; j++) {
+      parity ^= (data >> j) & 1;
+    }
+    // start bit, 8 data bits, parity bit, 2 stop bits
+    uint32_t bits = (0b11 << 10) | (parity << 9) | ((data & 0xFF) << 1);
+
+    double bit_period = (double)this->clk_freq / baudrate;
+
+    bool valid = false;
+    *errors = false;
+    // The line is idle during one bit time after the stop bits
+    uint32_t num_cycles = ceil(13 * bit_period);
+    for(uint32_t n = 0; n < num_cycles; n++) {
+      uint32_t bit = floor((n + phase) / bit_period);
+      this->core->uart_rx_i = (bit < 12) ? ((bits >> bit) & 1) : 1;
+      this->tick();
+
+      if(this->core->output_valid_o) {
+        valid = true;
+        *frame = this->core->frame_o;
+        *errors = this->core->parity_err_o || this->core->frame_err_o;
+      }
+    }
+    return valid;
+  }
+
+  /**
+   * Sends a frame with an address mark in place of the parity bit at 16
+   * clock cycles per bit.
+   * Returns true when the frame was output as valid.
+   */
+  bool inject_mpe_frame(uint32_t data, uint32_t mark, uint32_t * frame, bool * match) {
+    // (2**16)/16 = 4096 = 1 bit every 16 clk cycles
+    this->core->cr_acc_incr_i = 4096;
+    this->core->cr_ds_i = 1;
+    // The parity configuration is ignored in multiprocessor mode
+    this->core->cr_p_i = 1;
+    this->core->cr_s_i = 0;
+    this->core->cr_mpe_i = 1;
+
+    // start bit, 8 data bits, address mark, stop bit
+    uint32_t bits = (1 << 10) | ((mark & 1) << 9) | ((data & 0xFF) << 1);
+
+    bool valid = false;
+    *match = false;
+    for(uint32_t i = 0; i < 12; i++) {
+      for(uint32_t j = 0; j < 16; j++) {
+        // The line is idle after the stop bit
+        this->core->uart_rx_i = (i < 11) ? ((bits >> i) & 1) : 1;
+        this->tick();
+
+        if(this->core->output_valid_o) {
+          valid = true;
+          *frame = this->core->frame_o;
+        }
+        if(this->core->addr_match_o) {
+          *match = true;
+        }
+      }
+    }
+    return valid;
+  }
+
   void test_with_injected_frame(test_configuration_t config) {
-    this->core->cr_acc_incr_i = ((double)config.baudrate * (1 << 16)) / 24000000;
+    uint32_t acc_increment = (uint32_t)(((double)config.baudrate * (1 << 16)) / this->clk_freq) << 8;
+    this->core->cr_acc_incr_i = acc_increment >> 8;
+    this->core->cr_acc_frac_i = acc_increment & 0xFF;
     this->core->cr_ds_i = config.ds;
     this->core->cr_p_i = config.p;
     this->core->cr_s_i = config.s;
 
     this->tick();
 
-    set_injected_baudrate(this->core->cr_acc_incr_i);
+    set_injected_baudrate(acc_increment);
 
     // Send start bit
     this->core->uart_rx_i = 0;
@@ -226,7 +363,8 @@ void tb_rx_frontend_idle(TB_Rx_frontend * tb) {
   //`````````````````````````````````
   //      Checks 
   
-  tb->check(COND_state, (core->tb_rx_frontend->dut->state_q == S_IDLE));
+  tb->check(COND_state, (core->tb_rx_frontend->dut->state_q == S_IDLE) &&
+                        (core->idle_o == 1));
   tb->check(COND_valid, (core->output_valid_o == 0));
   
   //=================================
@@ -237,7 +375,8 @@ void tb_rx_frontend_idle(TB_Rx_frontend * tb) {
   //`````````````````````````````````
   //      Checks 
   
-  tb->check(COND_state, (core->tb_rx_frontend->dut->state_q == S_IDLE));
+  tb->check(COND_state, (core->tb_rx_frontend->dut->state_q == S_IDLE) &&
+                        (core->idle_o == 1));
   tb->check(COND_valid, (core->output_valid_o == 0));
 
   //=================================
@@ -248,7 +387,8 @@ void tb_rx_frontend_idle(TB_Rx_frontend * tb) {
   //`````````````````````````````````
   //      Checks 
   
-  tb->check(COND_state, (core->tb_rx_frontend->dut->state_q == S_IDLE));
+  tb->check(COND_state, (core->tb_rx_frontend->dut->state_q == S_IDLE) &&
+                        (core->idle_o == 1));
   tb->check(COND_valid, (core->output_valid_o == 0));
 
   //=================================
@@ -259,7 +399,8 @@ void tb_rx_frontend_idle(TB_Rx_frontend * tb) {
   //`````````````````````````````````
   //      Checks 
   
-  tb->check(COND_state, (core->tb_rx_frontend->dut->state_q == S_IDLE));
+  tb->check(COND_state, (core->tb_rx_frontend->dut->state_q == S_IDLE) &&
+                        (core->idle_o == 1));
   tb->check(COND_valid, (core->output_valid_o == 0));
 
   //`````````````````````````````````
@@ -945,6 +1086,553 @@ void tb_rx_frontend_baudrate(TB_Rx_frontend * tb) {
       "Failed to implement the valid signal", tb->err_cycles[COND_valid]);
 }
 
+/**
+ * @brief Receive frames driven at the ideal bit period of high baudrates
+ *        with a 100MHz clock. The line is not derived from the accumulator
+ *        increment so that its rounding error is exercised.
+ */
+void tb_rx_frontend_baudrate_high(TB_Rx_frontend * tb) {
+  Vtb_rx_frontend * core = tb->core;
+  core->testcase = T_BAUDRATE_HIGH;
+
+  // 100MHz
+  tb->clk_freq = 100000000;
+
+  //=================================
+  //      Tick (0)
+  
+  tb->reset();
+
+  //=================================
+  //      Tick (1-...)
+  
+  uint32_t baudrates[] = {
+    1000000,
+    3000000,
+    6000000,
+    8000000,
+    10000000,
+    12000000
+  };
+  size_t num_baudrates = sizeof(baudrates)/sizeof(uint32_t);
+
+  uint32_t data[] = {0b10100101, 0b00111100, 0x00, 0xFF};
+  size_t num_data = sizeof(data)/sizeof(uint32_t);
+
+  for(size_t i = 0; i < num_baudrates; i++) {
+    for(size_t j = 0; j < num_data; j++) {
+      // The start edge is shifted within the clock period
+      double phase = (double)j / num_data;
+
+      uint32_t frame = 0;
+      bool errors = false;
+      bool valid = tb->inject_nominal_frame(baudrates[i], data[j], phase, &frame, &errors);
+
+      uint8_t parity = 1;
+      for(int k = 0; k < 8; k++) {
+        parity ^= (data[j] >> k) & 1;
+      }
+      uint32_t expected_frame = (0b11 << 9) | (parity << 8) | data[j];
+
+      if(tb->debug_log && (!valid || (frame != expected_frame))) {
+        printf("Baudrate: %d, data: 0x%02X, frame: 0x%03X -> BAD\n", baudrates[i], data[j], frame);
+      }
+
+      //`````````````````````````````````
+      //      Checks 
+      
+      tb->check(COND_valid,  valid);
+      tb->check(COND_frame,  (frame == expected_frame));
+      tb->check(COND_errors, !errors);
+      tb->check(COND_state,  (core->tb_rx_frontend->dut->state_q == S_IDLE));
+    }
+  }
+
+  tb->clk_freq = 24000000;
+
+  //`````````````````````````````````
+  //      Formal Checks 
+  
+  CHECK("tb_rx_frontend.baudrate_high.01",
+      tb->conditions[COND_state],
+      "Failed to implement the state machine", tb->err_cycles[COND_state]);
+
+  CHECK("tb_rx_frontend.baudrate_high.02",
+      tb->conditions[COND_frame],
+      "Failed to implement the frame output", tb->err_cycles[COND_frame]);
+
+  CHECK("tb_rx_frontend.baudrate_high.03",
+      tb->conditions[COND_errors],
+      "Failed to implement the errors computation", tb->err_cycles[COND_errors]);
+
+  CHECK("tb_rx_frontend.baudrate_high.04",
+      tb->conditions[COND_valid],
+      "Failed to implement the valid signal", tb->err_cycles[COND_valid]);
+}
+
+void tb_rx_frontend_timeout(TB_Rx_frontend * tb) {
+  Vtb_rx_frontend * core = tb->core;
+  core->testcase = T_TIMEOUT;
+
+  test_configuration_t config = {
+    .baudrate = 2500000,
+    .data = 0b10100101,
+    .ds = 1,
+    .p = 0,
+    .s = 0,
+    .inject_frame_error = 0,
+    .inject_parity_error = 0
+  };
+  // 24MHz / 2.5MHz = 9.6 cycles per bit
+  uint32_t rto = 3;
+
+  //=================================
+  //      Tick (0)
+  
+  tb->reset();
+
+  //=================================
+  //      Tick (1-...)
+  
+  // The timeout is disabled
+  core->rtor_rto_i = 0;
+  tb->test_with_injected_frame(config);
+
+  uint32_t cycles = 0;
+  while((core->timeout_o == 0) && (cycles < 1000)) {
+    tb->tick();
+    cycles += 1;
+  }
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  tb->check(COND_timeout, (cycles == 1000));
+
+  //=================================
+  //      Tick (...)
+  
+  core->rtor_rto_i = rto;
+  tb->test_with_injected_frame(config);
+
+  cycles = 0;
+  while((core->timeout_o == 0) && (cycles < 1000)) {
+    tb->tick();
+    cycles += 1;
+
+    tb->check(COND_state, (core->tb_rx_frontend->dut->state_q == S_IDLE));
+  }
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  // The idle time is measured from the middle of the stop bit
+  tb->check(COND_timeout, (cycles >= (rto - 1) * 9) && (cycles <= rto * 10));
+
+  //=================================
+  //      Tick (...)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  tb->check(COND_timeout, (core->timeout_o == 0));
+
+  //=================================
+  //      Tick (...)
+  
+  // The timeout is only reported once after a frame
+  cycles = 0;
+  while((core->timeout_o == 0) && (cycles < 1000)) {
+    tb->tick();
+    cycles += 1;
+  }
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  tb->check(COND_timeout, (cycles == 1000));
+
+  //=================================
+  //      Tick (...)
+  
+  tb->test_with_injected_frame(config);
+
+  // Glitch shorter than half a bit on the idle line after the frame
+  core->uart_rx_i = 0;
+  tb->n_tick(3);
+  core->uart_rx_i = 1;
+
+  cycles = 3;
+  uint32_t false_starts = 0;
+  while((core->timeout_o == 0) && (cycles < 1000)) {
+    tb->tick();
+    cycles += 1;
+    false_starts += core->false_start_o;
+  }
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  // The false start does not cancel the timeout, which is delayed by at
+  // most the rejected half start bit
+  tb->check(COND_timeout, (false_starts == 1) && (cycles >= (rto - 1) * 9) && (cycles <= (rto + 1) * 10));
+
+  //`````````````````````````````````
+  //      Formal Checks 
+  
+  CHECK("tb_rx_frontend.timeout.01",
+      tb->conditions[COND_state],
+      "Failed to implement the state machine", tb->err_cycles[COND_state]);
+
+  CHECK("tb_rx_frontend.timeout.02",
+      tb->conditions[COND_timeout],
+      "Failed to implement the timeout signal", tb->err_cycles[COND_timeout]);
+}
+
+void tb_rx_frontend_oversampling(TB_Rx_frontend * tb) {
+  Vtb_rx_frontend * core = tb->core;
+  core->testcase = T_OVERSAMPLING;
+
+  uint32_t data = 0b10100101;
+  // Expected frame with a stop bit
+  uint32_t expected_frame = (1 << 8) | data;
+
+  //=================================
+  //      Tick (0)
+  
+  tb->reset();
+
+  //=================================
+  //      Tick (1-...)
+  
+  // A single cycle glitch is injected in the 4th data bit
+  // at each cycle of the bit
+  uint32_t corrupted = 0;
+  uint32_t middle_cycle = 0;
+  for(uint32_t j = 0; j < 16; j++) {
+    uint32_t frame = 0;
+    uint8_t noise = 0;
+    core->cr_ovs_i = 0;
+    bool valid = tb->inject_glitched_frame(data, 4, j, &frame, &noise);
+
+    tb->check(COND_valid, valid);
+    tb->check(COND_errors, (noise == 0));
+    if(frame != expected_frame) {
+      corrupted += 1;
+      middle_cycle = j;
+    }
+  }
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  // The glitch is only hit by the middle sample without oversampling
+  tb->check(COND_frame, (corrupted == 1));
+
+  //=================================
+  //      Tick (...)
+  
+  uint32_t noisy = 0;
+  uint32_t noisy_cycles = 0;
+  for(uint32_t j = 0; j < 16; j++) {
+    uint32_t frame = 0;
+    uint8_t noise = 0;
+    core->cr_ovs_i = 1;
+    bool valid = tb->inject_glitched_frame(data, 4, j, &frame, &noise);
+
+    tb->check(COND_valid, valid);
+    // The majority vote filters the glitch out
+    tb->check(COND_frame, (frame == expected_frame));
+    if(noise) {
+      noisy += 1;
+      noisy_cycles |= (1 << j);
+    }
+  }
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  // Each of the three samples is hit by the glitch once, the samples
+  // being taken 1/16 of a bit before, at and after the middle sample
+  tb->check(COND_errors, (noisy == 3) &&
+                         (noisy_cycles == (0x7u << (middle_cycle - 1))));
+
+  //`````````````````````````````````
+  //      Formal Checks 
+  
+  CHECK("tb_rx_frontend.oversampling.01",
+      tb->conditions[COND_frame],
+      "Failed to implement the majority vote", tb->err_cycles[COND_frame]);
+
+  CHECK("tb_rx_frontend.oversampling.02",
+      tb->conditions[COND_errors],
+      "Failed to implement the noise detection", tb->err_cycles[COND_errors]);
+
+  CHECK("tb_rx_frontend.oversampling.03",
+      tb->conditions[COND_valid],
+      "Failed to implement the valid signal", tb->err_cycles[COND_valid]);
+}
+
+void tb_rx_frontend_false_start(TB_Rx_frontend * tb) {
+  Vtb_rx_frontend * core = tb->core;
+  core->testcase = T_FALSE_START;
+
+  //=================================
+  //      Tick (0)
+  
+  tb->reset();
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  // (2**16)/16 = 4096 = 1 bit every 16 clk cycles
+  core->cr_acc_incr_i = 4096;
+  core->cr_ds_i = 1;
+
+  //=================================
+  //      Tick (1-3)
+  
+  // Glitch shorter than half a bit
+  core->uart_rx_i = 0;
+  tb->n_tick(3);
+
+  //=================================
+  //      Tick (4-...)
+  
+  core->uart_rx_i = 1;
+
+  uint32_t false_starts = 0;
+  for(int i = 0; i < 32; i++) {
+    tb->tick();
+
+    //`````````````````````````````````
+    //      Checks 
+    
+    tb->check(COND_valid, (core->output_valid_o == 0));
+    if(core->false_start_o) {
+      false_starts += 1;
+      // The start bit is rejected at its middle
+      tb->check(COND_state, (core->tb_rx_frontend->dut->state_q == S_START));
+    }
+  }
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  tb->check(COND_valid, (false_starts == 1));
+  tb->check(COND_state, (core->tb_rx_frontend->dut->state_q == S_IDLE));
+
+  //=================================
+  //      Tick (...)
+  
+  // A valid frame is still received afterwards
+  uint32_t frame = 0;
+  uint8_t noise = 0;
+  bool valid = tb->inject_glitched_frame(0b10100101, 0xFF, 0, &frame, &noise);
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  tb->check(COND_frame, valid && (frame == ((1 << 8) | 0b10100101)));
+
+  //`````````````````````````````````
+  //      Formal Checks 
+  
+  CHECK("tb_rx_frontend.false_start.01",
+      tb->conditions[COND_state],
+      "Failed to implement the state machine", tb->err_cycles[COND_state]);
+
+  CHECK("tb_rx_frontend.false_start.02",
+      tb->conditions[COND_frame],
+      "Failed to implement the frame output", tb->err_cycles[COND_frame]);
+
+  CHECK("tb_rx_frontend.false_start.03",
+      tb->conditions[COND_valid],
+      "Failed to implement the false start signal", tb->err_cycles[COND_valid]);
+}
+
+/**
+ * @brief Hold the line low for several frames. A single break is expected
+ *        to be reported and the next frame to be received once the line
+ *        goes back high.
+ */
+void tb_rx_frontend_break(TB_Rx_frontend * tb) {
+  Vtb_rx_frontend * core = tb->core;
+  core->testcase = T_BREAK;
+
+  //=================================
+  //      Tick (0)
+  
+  tb->reset();
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  // (2**16)/16 = 4096 = 1 bit every 16 clk cycles
+  core->cr_acc_incr_i = 4096;
+  core->cr_ds_i = 1;
+
+  //=================================
+  //      Tick (1-640)
+  
+  // The line is held low for four frames
+  core->uart_rx_i = 0;
+
+  uint32_t breaks = 0, valids = 0;
+  for(int i = 0; i < 4 * 10 * 16; i++) {
+    tb->tick();
+
+    if(core->output_valid_o) {
+      valids += 1;
+
+      //`````````````````````````````````
+      //      Checks 
+      
+      tb->check(COND_errors, (core->break_o == 1) && (core->frame_err_o == 1));
+    }
+    breaks += core->break_o;
+  }
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  tb->check(COND_valid, (valids == 1) && (breaks == 1));
+  tb->check(COND_state, (core->tb_rx_frontend->dut->state_q == S_IDLE));
+
+  //=================================
+  //      Tick (641-...)
+  
+  core->uart_rx_i = 1;
+  tb->n_tick(16);
+
+  // A valid frame is received once the line went back high
+  uint32_t frame = 0;
+  uint8_t noise = 0;
+  bool valid = tb->inject_glitched_frame(0b10100101, 0xFF, 0, &frame, &noise);
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  tb->check(COND_frame, valid && (frame == ((1 << 8) | 0b10100101)));
+  tb->check(COND_errors, (core->break_o == 0));
+
+  //`````````````````````````````````
+  //      Formal Checks 
+  
+  CHECK("tb_rx_frontend.break.01",
+      tb->conditions[COND_state],
+      "Failed to implement the state machine", tb->err_cycles[COND_state]);
+
+  CHECK("tb_rx_frontend.break.02",
+      tb->conditions[COND_frame],
+      "Failed to implement the frame output", tb->err_cycles[COND_frame]);
+
+  CHECK("tb_rx_frontend.break.03",
+      tb->conditions[COND_valid],
+      "Failed to implement the valid signal", tb->err_cycles[COND_valid]);
+
+  CHECK("tb_rx_frontend.break.04",
+      tb->conditions[COND_errors],
+      "Failed to implement the break signal", tb->err_cycles[COND_errors]);
+}
+
+/**
+ * @brief Send address and data frames in multiprocessor mode. Only the data
+ *        frames following a matching address are expected to be output.
+ */
+void tb_rx_frontend_mpe(TB_Rx_frontend * tb) {
+  Vtb_rx_frontend * core = tb->core;
+  core->testcase = T_MPE;
+
+  //=================================
+  //      Tick (0)
+  
+  tb->reset();
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  core->mpe_addr_i = 0x12;
+  core->mpe_mask_i = 0xFF;
+
+  //=================================
+  //      Tick (...)
+  
+  typedef struct {
+    uint32_t data;
+    uint32_t mark;
+    bool valid;
+    bool match;
+  } mpe_frame_t;
+
+  mpe_frame_t frames[] = {
+    // The node is not selected after reset
+    {0x55, 0, false, false},
+    {0x34, 1, false, false},
+    // Matching address
+    {0x12, 1, false, true},
+    {0x55, 0, true,  false},
+    {0x66, 0, true,  false},
+    // Another node is selected
+    {0x34, 1, false, false},
+    {0x77, 0, false, false}
+  };
+  size_t num_frames = sizeof(frames)/sizeof(mpe_frame_t);
+
+  for(size_t i = 0; i < num_frames; i++) {
+    uint32_t frame = 0;
+    bool match = false;
+    bool valid = tb->inject_mpe_frame(frames[i].data, frames[i].mark, &frame, &match);
+
+    //`````````````````````````````````
+    //      Checks 
+    
+    tb->check(COND_valid, (valid == frames[i].valid) && (match == frames[i].match));
+    if(frames[i].valid) {
+      tb->check(COND_frame, ((frame & 0xFF) == frames[i].data) && (((frame >> 8) & 1) == 0));
+    }
+  }
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  // Only the upper nibble of the address is compared
+  core->mpe_mask_i = 0xF0;
+
+  //=================================
+  //      Tick (...)
+  
+  uint32_t frame = 0;
+  bool match = false;
+  bool valid = tb->inject_mpe_frame(0x1F, 1, &frame, &match);
+  tb->check(COND_valid, !valid && match);
+  valid = tb->inject_mpe_frame(0x88, 0, &frame, &match);
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  tb->check(COND_valid, valid && !match);
+  tb->check(COND_frame, ((frame & 0xFF) == 0x88));
+  tb->check(COND_errors, (core->parity_err_o == 0));
+
+  //`````````````````````````````````
+  //      Formal Checks 
+  
+  CHECK("tb_rx_frontend.mpe.01",
+      tb->conditions[COND_valid],
+      "Failed to implement the address filtering", tb->err_cycles[COND_valid]);
+
+  CHECK("tb_rx_frontend.mpe.02",
+      tb->conditions[COND_frame],
+      "Failed to implement the frame output", tb->err_cycles[COND_frame]);
+
+  CHECK("tb_rx_frontend.mpe.03",
+      tb->conditions[COND_errors],
+      "Failed to implement the errors computation", tb->err_cycles[COND_errors]);
+}
+
 int main(int argc, char ** argv, char ** env) {
   srand(time(NULL));
   Verilated::traceEverOn(true);
@@ -982,6 +1670,13 @@ int main(int argc, char ** argv, char ** env) {
   tb_rx_frontend_framing(tb);
 
   tb_rx_frontend_baudrate(tb);
+  tb_rx_frontend_baudrate_high(tb);
+
+  tb_rx_frontend_timeout(tb);
+  tb_rx_frontend_oversampling(tb);
+  tb_rx_frontend_false_start(tb);
+  tb_rx_frontend_break(tb);
+  tb_rx_frontend_mpe(tb);
 
   /************************************************************/
 
@@ -28,16 +28,30 @@ module tb_rx_frontend
   input   logic         rst_i,
 
   input   logic[15:0]   cr_acc_incr_i,
+  input   logic[7:0]    cr_acc_frac_i,
   input   logic         cr_ds_i,
   input   logic[1:0]    cr_p_i,
   input   logic         cr_s_i,
+  input   logic         cr_ovs_i,
+
+  input   logic         cr_mpe_i,
+  input   logic[7:0]    mpe_addr_i,
+  input   logic[7:0]    mpe_mask_i,
+
+  input   logic[7:0]    rtor_rto_i,
 
   input   logic         uart_rx_i,
 
   output  logic[10:0]   frame_o,
   output  logic         parity_err_o,
   output  logic         frame_err_o,
-  output  logic         output_valid_o
+  output  logic         noise_err_o,
+  output  logic         break_o,
+  output  logic         output_valid_o,
+  output  logic         addr_match_o,
+  output  logic         false_start_o,
+  output  logic         timeout_o,
+  output  logic         idle_o
 );
 
 rx_frontend dut (
@@ -45,16 +59,30 @@ rx_frontend dut (
   .rst_i           (rst_i),
                  
   .cr_acc_incr_i    (cr_acc_incr_i),
+  .cr_acc_frac_i    (cr_acc_frac_i),
   .cr_ds_i         (cr_ds_i),
   .cr_p_i          (cr_p_i),
   .cr_s_i          (cr_s_i),
+  .cr_ovs_i        (cr_ovs_i),
+
+  .cr_mpe_i        (cr_mpe_i),
+  .mpe_addr_i      (mpe_addr_i),
+  .mpe_mask_i      (mpe_mask_i),
+
+  .rtor_rto_i      (rtor_rto_i),
 
   .uart_rx_i       (uart_rx_i),
                  
   .frame_o         (frame_o),
   .parity_err_o    (parity_err_o),
   .frame_err_o     (frame_err_o),
-  .output_valid_o  (output_valid_o)
+  .noise_err_o     (noise_err_o),
+  .break_o         (break_o),
+  .output_valid_o  (output_valid_o),
+  .addr_match_o    (addr_match_o),
+  .false_start_o   (false_start_o),
+  .timeout_o       (timeout_o),
+  .idle_o          (idle_o)
 );
 
 endmodule // tb_rx_frontend
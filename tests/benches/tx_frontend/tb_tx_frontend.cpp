@@ -23,6 +23,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <time.h>
+#include <math.h>
 #include <verilated.h>
 #include <verilated_vcd_c.h>
 #include <svdpi.h>
@@ -36,6 +37,7 @@ enum CondId {
   COND_output,
   COND_done,
   COND_baudrate,
+  COND_state,
   __CondIdEnd
 };
 
@@ -53,7 +55,13 @@ enum TestcaseId {
   T_8E2      = 11,
   T_8O1      = 12,
   T_8O2      = 13,
-  T_BAUDRATE = 14
+  T_BAUDRATE = 14,
+  T_BACK_TO_BACK = 15,
+  T_BAUDRATE_HIGH = 16,
+  T_BREAK    = 17,
+  T_MPE      = 18,
+  T_DE       = 19,
+  T_START    = 20
 };
 
 enum StateId {
@@ -61,7 +69,10 @@ enum StateId {
   S_START  = 1,
   S_DATA   = 2,
   S_PARITY = 3,
-  S_STOP   = 4
+  S_STOP   = 4,
+  S_BREAK  = 5,
+  S_LEAD   = 6,
+  S_TRAIL  = 7
 };
 
 class TB_Tx_frontend : public Testbench<Vtb_tx_frontend> {
@@ -80,12 +91,21 @@ public:
   
   void _nop() {
     core->cr_acc_incr_i = 0;
+    core->cr_acc_frac_i = 0;
     core->cr_ds_i = 0;
     core->cr_p_i = 0;
     core->cr_s_i = 0;
+    core->cr_mpe_i = 0;
 
     core->transmit_i = 0;
     core->dr_i = 0;
+    core->mark_i = 0;
+
+    core->break_i = 0;
+    core->break_len_i = 0;
+
+    core->de_lead_i = 0;
+    core->de_trail_i = 0;
   }
 
   float get_generated_baudrate(uint32_t baudrate) {
@@ -126,6 +146,61 @@ public:
     float generated_baudrate = (1.0 / baud_period);
     return generated_baudrate;
   }
+
+  /**
+   * Transmits a 8O2 frame and samples the line in the middle of each bit
+   * of the ideal bit period, as a receiver running at the nominal
+   * baudrate would.
+   * Returns true when all the sampled bits match the frame.
+   */
+  bool transmit_nominal_frame(uint32_t baudrate, uint32_t freq, uint32_t data) {
+    this->_nop();
+
+    this->core->rst_i = 1;
+    for(int i = 0; i < 5; i++) {
+      this->tick();
+    }
+    this->core->rst_i = 0;
+
+    // 8 bits of fractional increment
+    uint32_t acc_increment = round(((double)baudrate * (1 << 24)) / freq);
+    core->cr_acc_incr_i = acc_increment >> 8;
+    core->cr_acc_frac_i = acc_increment & 0xFF;
+    core->cr_ds_i = 1;
+    core->cr_p_i = 1;
+    core->cr_s_i = 1;
+
+    core->transmit_i = 1;
+    core->dr_i = data;
+
+    // Wait for the tx signal to go down
+    while(core->uart_tx_o == 1) {
+      this->tick();
+    }
+    core->transmit_i = 0;
+
+    uint8_t parity = 1;
+    for(int j = 0; j < 8; j++) {
+      parity ^= (data >> j) & 1;
+    }
+    // start bit, 8 data bits, parity bit, 2 stop bits
+    uint32_t bits = (0b11 << 10) | (parity << 9) | ((data & 0xFF) << 1);
+
+    double bit_period = (double)freq / baudrate;
+
+    // The start edge occurred at cycle 0
+    bool ok = true;
+    uint32_t cycle = 0;
+    for(uint32_t k = 0; k < 12; k++) {
+      uint32_t sample = (k + 0.5) * bit_period;
+      while(cycle < sample) {
+        this->tick();
+        cycle += 1;
+      }
+      ok = ok && (core->uart_tx_o == ((bits >> k) & 1));
+    }
+    return ok;
+  }
 };
 
 void tb_tx_frontend_idle(TB_Tx_frontend * tb) {
@@ -148,6 +223,7 @@ void tb_tx_frontend_idle(TB_Tx_frontend * tb) {
   
   tb->check(COND_output, (core->uart_tx_o == 1));
   tb->check(COND_done,   (core->done_o == 0));
+  tb->check(COND_state,  (core->idle_o == 1));
   
   //=================================
   //      Tick (1)
@@ -159,6 +235,7 @@ void tb_tx_frontend_idle(TB_Tx_frontend * tb) {
   
   tb->check(COND_output, (core->uart_tx_o == 1));
   tb->check(COND_done,   (core->done_o == 0));
+  tb->check(COND_state,  (core->idle_o == 1));
 
   //=================================
   //      Tick (2)
@@ -170,6 +247,7 @@ void tb_tx_frontend_idle(TB_Tx_frontend * tb) {
   
   tb->check(COND_output, (core->uart_tx_o == 1));
   tb->check(COND_done,   (core->done_o == 0));
+  tb->check(COND_state,  (core->idle_o == 1));
 
   //=================================
   //      Tick (3)
@@ -181,6 +259,7 @@ void tb_tx_frontend_idle(TB_Tx_frontend * tb) {
   
   tb->check(COND_output, (core->uart_tx_o == 1));
   tb->check(COND_done,   (core->done_o == 0));
+  tb->check(COND_state,  (core->idle_o == 1));
 
   //`````````````````````````````````
   //      Formal Checks 
@@ -192,6 +271,10 @@ void tb_tx_frontend_idle(TB_Tx_frontend * tb) {
   CHECK("tb_tx_frontend.idle.02",
       tb->conditions[COND_done],
       "Failed to implement the done signal", tb->err_cycles[COND_done]);
+
+  CHECK("tb_tx_frontend.idle.03",
+      tb->conditions[COND_state],
+      "Failed to implement the idle signal", tb->err_cycles[COND_state]);
 }
 
 void tb_tx_frontend_7N1(TB_Tx_frontend * tb) {
@@ -2807,6 +2890,513 @@ void tb_tx_frontend_baudrate(TB_Tx_frontend * tb) {
       "Failed to comply with the baudrate precision", tb->err_cycles[COND_baudrate]);
 }
 
+/**
+ * @brief Send two frames with transmit_i held asserted.
+ *        The second frame is expected to start right after the last stop bit
+ *        of the first frame without going through the IDLE state.
+ */
+void tb_tx_frontend_back_to_back(TB_Tx_frontend * tb) {
+  Vtb_tx_frontend * core = tb->core;
+  core->testcase = T_BACK_TO_BACK;
+
+  //=================================
+  //      Tick (0)
+  
+  tb->reset();
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  // (2**16)/4 = 16384 = 1 bit every 4 clk cycles
+  core->cr_acc_incr_i = 16384;
+  core->cr_ds_i = 1;
+  core->cr_p_i = 0;
+  core->cr_s_i = 0;
+
+  core->transmit_i = 1;
+  core->dr_i = 0x3A;
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  tb->check(COND_state, (core->ready_o == 1));
+
+  //=================================
+  //      Tick (1)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  tb->check(COND_state, (core->tb_tx_frontend->dut->state_q == S_START) &&
+                        (core->ready_o == 0));
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  core->dr_i = 0xC5;
+
+  //=================================
+  //      Tick (2-41)
+  
+  // 1 start bit, 8 data bits, 1 stop bit
+  uint32_t number_of_tx_bits = (1 + 8 + 1) * 4;
+  uint32_t num_ready = 0;
+  for(uint32_t i = 0; i < number_of_tx_bits; i++) {
+    num_ready += core->ready_o;
+
+    tb->tick();
+
+    //`````````````````````````````````
+    //      Checks 
+    
+    tb->check(COND_state, (core->tb_tx_frontend->dut->state_q != S_IDLE));
+  }
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  // The second frame starts exactly one frame after the first one
+  tb->check(COND_state, (core->tb_tx_frontend->dut->state_q == S_START) &&
+                        (num_ready == 1));
+  tb->check(COND_done,  (core->done_o == 1));
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  core->transmit_i = 0;
+
+  //=================================
+  //      Tick (42)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  tb->check(COND_output, (core->uart_tx_o == 0));
+  tb->check(COND_done,   (core->done_o == 0));
+
+  //=================================
+  //      Tick (43-82)
+  
+  for(uint32_t i = 0; i < number_of_tx_bits; i++) {
+    tb->tick();
+  }
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  // The fifo is empty so the frontend goes back to IDLE
+  tb->check(COND_state, (core->tb_tx_frontend->dut->state_q == S_IDLE));
+
+  //`````````````````````````````````
+  //      Formal Checks 
+  
+  CHECK("tb_tx_frontend.back_to_back.01",
+      tb->conditions[COND_output],
+      "Failed to implement the output signal", tb->err_cycles[COND_output]);
+
+  CHECK("tb_tx_frontend.back_to_back.02",
+      tb->conditions[COND_done],
+      "Failed to implement the done signal", tb->err_cycles[COND_done]);
+
+  CHECK("tb_tx_frontend.back_to_back.03",
+      tb->conditions[COND_state],
+      "Failed to implement the state machine", tb->err_cycles[COND_state]);
+}
+
+/**
+ * @brief Measure high baudrates generated from a 100MHz clock using the
+ *        fractional part of the accumulator increment.
+ */
+/**
+ * @brief Transmit frames at high baudrates with a 100MHz clock. The line
+ *        is sampled at the ideal bit period rather than measured from the
+ *        accumulator so that its rounding error is exercised.
+ */
+void tb_tx_frontend_baudrate_high(TB_Tx_frontend * tb) {
+  Vtb_tx_frontend * core = tb->core;
+  core->testcase = T_BAUDRATE_HIGH;
+
+  uint32_t baudrates[] = {
+    1000000,
+    3000000,
+    4000000,
+    6000000,
+    8000000,
+    10000000,
+    12000000
+  };
+  size_t num_baudrates = sizeof(baudrates)/sizeof(uint32_t);
+
+  uint32_t data[] = {0b10100101, 0b00111100, 0x00, 0xFF};
+  size_t num_data = sizeof(data)/sizeof(uint32_t);
+
+  for(size_t i = 0; i < num_baudrates; i++) {
+    for(size_t j = 0; j < num_data; j++) {
+      bool ok = tb->transmit_nominal_frame(baudrates[i], 100000000, data[j]);
+
+      if(tb->debug_log && !ok) {
+        printf("Baudrate: %d, data: 0x%02X -> BAD\n", baudrates[i], data[j]);
+      }
+
+      //`````````````````````````````````
+      //      Checks 
+      
+      tb->check(COND_output, ok);
+    }
+  }
+
+  //`````````````````````````````````
+  //      Formal Checks 
+  
+  CHECK("tb_tx_frontend.baudrate_high.01",
+      tb->conditions[COND_output],
+      "Failed to implement the output signal", tb->err_cycles[COND_output]);
+}
+
+/**
+ * @brief Send a break of three bit times followed by a frame.
+ *        The break has priority over the frame and is followed by the stop
+ *        bits.
+ */
+void tb_tx_frontend_break(TB_Tx_frontend * tb) {
+  Vtb_tx_frontend * core = tb->core;
+  core->testcase = T_BREAK;
+
+  //=================================
+  //      Tick (0)
+  
+  tb->reset();
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  // (2**16)/4 = 16384 = 1 bit every 4 clk cycles
+  core->cr_acc_incr_i = 16384;
+  core->cr_ds_i = 1;
+  core->cr_p_i = 0;
+  core->cr_s_i = 0;
+
+  core->transmit_i = 1;
+  core->dr_i = 0x3A;
+
+  core->break_i = 1;
+  core->break_len_i = 2;
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  tb->check(COND_state, (core->ready_o == 0));
+
+  //=================================
+  //      Tick (1)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  tb->check(COND_state, (core->tb_tx_frontend->dut->state_q == S_BREAK));
+
+  //=================================
+  //      Tick (2-13)
+  
+  // The break lasts break_len_i + 1 bit times
+  uint32_t number_of_break_cycles = (2 + 1) * 4;
+  uint32_t num_low = 0;
+  for(uint32_t i = 0; i < number_of_break_cycles; i++) {
+    //`````````````````````````````````
+    //      Checks 
+    
+    tb->check(COND_done, (core->break_done_o == (i == (number_of_break_cycles - 1))) &&
+                         (core->ready_o == 0));
+
+    tb->tick();
+
+    num_low += (core->uart_tx_o == 0);
+  }
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  tb->check(COND_output, (num_low == number_of_break_cycles));
+  tb->check(COND_state,  (core->tb_tx_frontend->dut->state_q == S_STOP));
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  core->break_i = 0;
+
+  //=================================
+  //      Tick (14-17)
+  
+  for(uint32_t i = 0; i < 4; i++) {
+    tb->tick();
+
+    //`````````````````````````````````
+    //      Checks 
+    
+    tb->check(COND_output, (core->uart_tx_o == 1));
+  }
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  // The frame is sent right after the stop bit of the break
+  tb->check(COND_state, (core->tb_tx_frontend->dut->state_q == S_START));
+
+  //`````````````````````````````````
+  //      Formal Checks 
+  
+  CHECK("tb_tx_frontend.break.01",
+      tb->conditions[COND_output],
+      "Failed to implement the output signal", tb->err_cycles[COND_output]);
+
+  CHECK("tb_tx_frontend.break.02",
+      tb->conditions[COND_done],
+      "Failed to implement the break done signal", tb->err_cycles[COND_done]);
+
+  CHECK("tb_tx_frontend.break.03",
+      tb->conditions[COND_state],
+      "Failed to implement the state machine", tb->err_cycles[COND_state]);
+}
+
+/**
+ * @brief Send an address frame and a data frame in multiprocessor mode.
+ *        The address mark is expected in place of the parity bit.
+ */
+void tb_tx_frontend_mpe(TB_Tx_frontend * tb) {
+  Vtb_tx_frontend * core = tb->core;
+  core->testcase = T_MPE;
+
+  for(uint32_t mark = 0; mark < 2; mark++) {
+    //=================================
+    //      Tick (0)
+    
+    tb->reset();
+
+    //`````````````````````````````````
+    //      Set inputs
+    
+    // (2**16)/4 = 16384 = 1 bit every 4 clk cycles
+    core->cr_acc_incr_i = 16384;
+    core->cr_ds_i = 1;
+    core->cr_p_i = 1;
+    core->cr_s_i = 0;
+    core->cr_mpe_i = 1;
+
+    core->transmit_i = 1;
+    core->dr_i = 0xA5;
+    core->mark_i = mark;
+
+    //=================================
+    //      Tick (1)
+    
+    tb->tick();
+
+    //`````````````````````````````````
+    //      Set inputs
+    
+    core->transmit_i = 0;
+
+    //=================================
+    //      Tick (2-45)
+    
+    // 1 start bit, 8 data bits, 1 address mark, 1 stop bit
+    // Each bit is sampled at the middle of its baud interval
+    uint32_t bits = 0;
+    for(uint32_t i = 0; i < (1 + 8 + 1 + 1) * 4; i++) {
+      tb->tick();
+      if((i % 4) == 1) {
+        bits |= (uint32_t)core->uart_tx_o << (i / 4);
+      }
+    }
+
+    //`````````````````````````````````
+    //      Checks 
+    
+    // The parity configuration is ignored
+    uint32_t expected_bits = (1 << 10) | (mark << 9) | (0xA5 << 1);
+    tb->check(COND_output, (bits == expected_bits));
+    tb->check(COND_state,  (core->tb_tx_frontend->dut->state_q == S_IDLE));
+  }
+
+  //`````````````````````````````````
+  //      Formal Checks 
+  
+  CHECK("tb_tx_frontend.mpe.01",
+      tb->conditions[COND_output],
+      "Failed to implement the output signal", tb->err_cycles[COND_output]);
+
+  CHECK("tb_tx_frontend.mpe.02",
+      tb->conditions[COND_state],
+      "Failed to implement the state machine", tb->err_cycles[COND_state]);
+}
+
+/**
+ * @brief Send a frame with and without driver enable guard times.
+ *        The driver enable is expected to be asserted the given number of
+ *        bit times before the start bit and after the stop bit.
+ */
+void tb_tx_frontend_de(TB_Tx_frontend * tb) {
+  Vtb_tx_frontend * core = tb->core;
+  core->testcase = T_DE;
+
+  uint32_t guard_times[][2] = {
+    {2, 3},
+    {0, 0}
+  };
+
+  for(uint32_t n = 0; n < 2; n++) {
+    uint32_t lead = guard_times[n][0];
+    uint32_t trail = guard_times[n][1];
+
+    //=================================
+    //      Tick (0)
+    
+    tb->reset();
+
+    //`````````````````````````````````
+    //      Set inputs
+    
+    // (2**16)/4 = 16384 = 1 bit every 4 clk cycles
+    core->cr_acc_incr_i = 16384;
+    core->cr_ds_i = 1;
+    core->cr_p_i = 0;
+    core->cr_s_i = 0;
+
+    core->de_lead_i = lead;
+    core->de_trail_i = trail;
+
+    core->transmit_i = 1;
+    core->dr_i = 0xA5;
+
+    //=================================
+    //      Tick (1)
+    
+    tb->tick();
+
+    //`````````````````````````````````
+    //      Checks 
+    
+    tb->check(COND_state, (core->tb_tx_frontend->dut->state_q == (lead ? S_LEAD : S_START)));
+
+    //`````````````````````````````````
+    //      Set inputs
+    
+    core->transmit_i = 0;
+
+    //=================================
+    //      Tick (2-80)
+    
+    int first_de = -1, last_de = -1, first_low = -1;
+    uint32_t num_de = 0;
+    for(int t = 2; t <= 80; t++) {
+      tb->tick();
+
+      if(core->uart_de_o) {
+        if(first_de < 0) {
+          first_de = t;
+        }
+        last_de = t;
+        num_de += 1;
+      }
+      if((first_low < 0) && (core->uart_tx_o == 0)) {
+        first_low = t;
+      }
+    }
+
+    //`````````````````````````````````
+    //      Checks 
+    
+    // 1 start bit, 8 data bits, 1 stop bit
+    int last_frame_tick = first_low + (1 + 8 + 1) * 4 - 1;
+    tb->check(COND_output, (first_de >= 0) && (first_low >= 0) &&
+                           (num_de == (uint32_t)(last_de - first_de + 1)));
+    tb->check(COND_output, (first_low - first_de) == (int)(lead * 4));
+    tb->check(COND_output, (last_de - last_frame_tick) == (int)(trail * 4));
+    tb->check(COND_state, (core->tb_tx_frontend->dut->state_q == S_IDLE));
+  }
+
+  //`````````````````````````````````
+  //      Formal Checks 
+  
+  CHECK("tb_tx_frontend.de.01",
+      tb->conditions[COND_output],
+      "Failed to implement the driver enable signal", tb->err_cycles[COND_output]);
+
+  CHECK("tb_tx_frontend.de.02",
+      tb->conditions[COND_state],
+      "Failed to implement the state machine", tb->err_cycles[COND_state]);
+}
+
+void tb_tx_frontend_start(TB_Tx_frontend * tb) {
+  Vtb_tx_frontend * core = tb->core;
+  core->testcase = T_START;
+
+  //=================================
+  //      Tick (0)
+  
+  tb->reset();
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  // (2**16)/4 = 16384 = 1 bit every 4 clk cycles
+  core->cr_acc_incr_i = 16384;
+  core->cr_ds_i = 1;
+  core->cr_p_i = 0;
+  core->cr_s_i = 0;
+
+  core->transmit_i = 1;
+  core->dr_i = 0xA5;
+
+  //=================================
+  //      Tick (1)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  core->transmit_i = 0;
+
+  //=================================
+  //      Tick (2-60)
+  
+  int first_low = -1, first_start = -1;
+  uint32_t num_start = 0;
+  for(int t = 2; t <= 60; t++) {
+    tb->tick();
+
+    if((first_low < 0) && (core->uart_tx_o == 0)) {
+      first_low = t;
+    }
+    if(core->start_o) {
+      if(first_start < 0) {
+        first_start = t;
+      }
+      num_start += 1;
+    }
+  }
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  // The start signal is only asserted on the first cycle of the start bit
+  tb->check(COND_output, (first_low >= 0) && (first_start == first_low) && (num_start == 1));
+
+  //`````````````````````````````````
+  //      Formal Checks 
+  
+  CHECK("tb_tx_frontend.start.01",
+      tb->conditions[COND_output],
+      "Failed to implement the start signal", tb->err_cycles[COND_output]);
+}
+
 int main(int argc, char ** argv, char ** env) {
   srand(time(NULL));
   Verilated::traceEverOn(true);
@@ -2841,6 +3431,14 @@ int main(int argc, char ** argv, char ** env) {
 
   tb_tx_frontend_baudrate(tb);
 
+  tb_tx_frontend_back_to_back(tb);
+  tb_tx_frontend_baudrate_high(tb);
+
+  tb_tx_frontend_break(tb);
+  tb_tx_frontend_mpe(tb);
+  tb_tx_frontend_de(tb);
+  tb_tx_frontend_start(tb);
+
   /************************************************************/
 
   printf("[TX_FRONTEND]: ");
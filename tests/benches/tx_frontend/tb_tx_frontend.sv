@@ -28,16 +28,30 @@ module tb_tx_frontend
   input   logic         rst_i,
 
   input   logic[15:0]   cr_acc_incr_i,
+  input   logic[7:0]    cr_acc_frac_i,
   input   logic         cr_ds_i,
   input   logic[1:0]    cr_p_i,
   input   logic         cr_s_i,
+  input   logic         cr_mpe_i,
 
   input   logic         transmit_i,
   input   logic[7:0]    dr_i,
+  input   logic         mark_i,
+  output  logic         ready_o,
+
+  input   logic         break_i,
+  input   logic[7:0]    break_len_i,
+  output  logic         break_done_o,
+
+  input   logic[7:0]    de_lead_i,
+  input   logic[7:0]    de_trail_i,
 
   output  logic         done_o,
+  output  logic         start_o,
+  output  logic         idle_o,
 
-  output  logic         uart_tx_o
+  output  logic         uart_tx_o,
+  output  logic         uart_de_o
 );
 
 tx_frontend dut (
@@ -45,16 +59,30 @@ tx_frontend dut (
   .rst_i           (rst_i),
                  
   .cr_acc_incr_i   (cr_acc_incr_i),
+  .cr_acc_frac_i   (cr_acc_frac_i),
   .cr_ds_i         (cr_ds_i),
   .cr_p_i          (cr_p_i),
   .cr_s_i          (cr_s_i),
+  .cr_mpe_i        (cr_mpe_i),
 
   .transmit_i      (transmit_i),
   .dr_i            (dr_i),
+  .mark_i          (mark_i),
+  .ready_o         (ready_o),
+
+  .break_i         (break_i),
+  .break_len_i     (break_len_i),
+  .break_done_o    (break_done_o),
+
+  .de_lead_i       (de_lead_i),
+  .de_trail_i      (de_trail_i),
                  
   .done_o          (done_o),
+  .start_o         (start_o),
+  .idle_o          (idle_o),
 
-  .uart_tx_o       (uart_tx_o)
+  .uart_tx_o       (uart_tx_o),
+  .uart_de_o       (uart_de_o)
 );
 
 endmodule // tb_tx_frontend